@@ -0,0 +1,34 @@
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "aecs/component/type.hpp"
+
+// Not part of the benchmarks executable, compiled by the
+// compile_time_benchmarks target once per component hash to time how long
+// the compiler spends hashing the names of type_count component types.
+namespace
+{
+constexpr std::size_t type_count = 800;
+
+template<std::size_t I>
+struct component
+{
+    int value;
+};
+
+template<std::size_t... Is>
+constexpr auto hashes(std::index_sequence<Is...>)
+{
+    return std::array<std::size_t, sizeof...(Is)>{
+        aecs::component_type<component<Is>>::hash()...};
+}
+
+constexpr auto component_hashes =
+    hashes(std::make_index_sequence<type_count>{});
+} // namespace
+
+int main()
+{
+    return component_hashes[0] == component_hashes[1];
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include "aecs/component/type.hpp"
+#include "aecs/utility/fnv1a.hpp"
+#include "aecs/utility/sha1.hpp"
+
+#include "harness.hpp"
+
+// component_type<T>::hash() is always folded into a constant, its cost is
+// paid by the compiler evaluating the name hash over the component name. The
+// same evaluation is measured here at runtime over the names of type_count
+// components, which tracks the work the constant evaluator has to do per
+// component type. The compile_time_benchmarks target times the compiler
+// itself.
+namespace
+{
+constexpr std::size_t type_count = 64;
+
+template<std::size_t I>
+struct component
+{
+    int value;
+};
+
+template<std::size_t... Is>
+constexpr auto names(std::index_sequence<Is...>)
+{
+    return std::array<std::string_view, sizeof...(Is)>{
+        aecs::component_type<component<Is>>::name()...};
+}
+
+template<std::size_t... Is>
+constexpr auto hashes(std::index_sequence<Is...>)
+{
+    return std::array<std::size_t, sizeof...(Is)>{
+        aecs::component_type<component<Is>>::hash()...};
+}
+
+constexpr auto component_names = names(std::make_index_sequence<type_count>{});
+constexpr auto component_hashes =
+    hashes(std::make_index_sequence<type_count>{});
+} // namespace
+
+AECS_BENCHMARK(component_hash_runtime_sha1, type_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        for (auto name : component_names)
+        {
+            aecs::bench::do_not_optimize(name);
+            aecs::bench::do_not_optimize(aecs::sha1(name));
+        }
+    }
+}
+
+AECS_BENCHMARK(component_hash_runtime_fnv1a, type_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        for (auto name : component_names)
+        {
+            aecs::bench::do_not_optimize(name);
+            aecs::bench::do_not_optimize(aecs::fnv1a(name));
+        }
+    }
+}
+
+// the constant folded hashes, only the load remains.
+AECS_BENCHMARK(component_hash_constant, type_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        for (auto hash : component_hashes)
+        {
+            aecs::bench::do_not_optimize(hash);
+        }
+    }
+}
\ No newline at end of file
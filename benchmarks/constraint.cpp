@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <utility>
+
+#include "aecs/component/registry.hpp"
+#include "aecs/entity/constraint.hpp"
+
+#include "harness.hpp"
+
+// constraint_view::allow_parallelism compares every pair of constraints, so
+// it's measured with growing list sizes. Both lists access disjoint
+// components, the worst case where no early exit happens. access_mask is the
+// word wise alternative used by the scheduler.
+namespace
+{
+template<std::size_t I>
+struct component
+{
+    int value;
+};
+
+template<std::size_t Offset, std::size_t... Is>
+constexpr auto make_list(aecs::entity::access a, std::index_sequence<Is...>)
+{
+    return aecs::entity::constraint_list{aecs::entity::constraint{
+        a, std::in_place_type<component<Offset + Is>>}...};
+}
+
+template<std::size_t N>
+void constraint_benchmark(aecs::bench::state& state)
+{
+    using aecs::entity::access;
+
+    static constexpr auto writes =
+        make_list<0>(access::write, std::make_index_sequence<N>{});
+    static constexpr auto reads =
+        make_list<N>(access::read, std::make_index_sequence<N>{});
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        // opaque, so the result can't be folded at compile time
+        const auto* w   = aecs::bench::opaque(writes.data());
+        const auto* r   = aecs::bench::opaque(reads.data());
+        const auto  lhs = aecs::entity::constraint_view{w, w + N};
+        const auto  rhs = aecs::entity::constraint_view{r, r + N};
+
+        aecs::bench::do_not_optimize(lhs.allow_parallelism(rhs));
+    }
+}
+
+template<std::size_t N>
+void mask_benchmark(aecs::bench::state& state)
+{
+    using aecs::entity::access;
+
+    static constexpr auto writes =
+        make_list<0>(access::write, std::make_index_sequence<N>{});
+    static constexpr auto reads =
+        make_list<N>(access::read, std::make_index_sequence<N>{});
+
+    state.pause();
+    auto components = aecs::component_registry{};
+    auto lhs        = components.make_access_mask(writes);
+    auto rhs        = components.make_access_mask(reads);
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        aecs::bench::do_not_optimize(lhs);
+        aecs::bench::do_not_optimize(rhs);
+        aecs::bench::do_not_optimize(lhs.allow_parallelism(rhs));
+    }
+}
+} // namespace
+
+AECS_BENCHMARK(allow_parallelism_1, 1)
+{
+    constraint_benchmark<1>(state);
+}
+
+AECS_BENCHMARK(allow_parallelism_4, 1)
+{
+    constraint_benchmark<4>(state);
+}
+
+AECS_BENCHMARK(allow_parallelism_16, 1)
+{
+    constraint_benchmark<16>(state);
+}
+
+AECS_BENCHMARK(allow_parallelism_64, 1)
+{
+    constraint_benchmark<64>(state);
+}
+
+AECS_BENCHMARK(access_mask_allow_parallelism_1, 1)
+{
+    mask_benchmark<1>(state);
+}
+
+AECS_BENCHMARK(access_mask_allow_parallelism_4, 1)
+{
+    mask_benchmark<4>(state);
+}
+
+AECS_BENCHMARK(access_mask_allow_parallelism_16, 1)
+{
+    mask_benchmark<16>(state);
+}
+
+AECS_BENCHMARK(access_mask_allow_parallelism_64, 1)
+{
+    mask_benchmark<64>(state);
+}
\ No newline at end of file
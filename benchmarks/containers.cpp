@@ -0,0 +1,192 @@
+#include <cstddef>
+#include <vector>
+
+#include "aecs/container/aligned.hpp"
+#include "aecs/container/bit_tag.hpp"
+#include "aecs/container/chunked.hpp"
+#include "aecs/container/soa.hpp"
+#include "aecs/container/tag.hpp"
+
+#include "harness.hpp"
+
+// Linear iteration over every column type, each iteration visits all
+// element_count elements once.
+namespace
+{
+constexpr std::size_t element_count = std::size_t{1} << 16;
+
+struct position
+{
+    float x, y, z;
+};
+
+struct is_active
+{};
+
+template<typename C>
+C make_filled()
+{
+    auto c = C{};
+
+    for (std::size_t i = 0; i != element_count; ++i)
+    {
+        c.push_back(position{float(i), 1, 2});
+    }
+
+    return c;
+}
+} // namespace
+
+AECS_BENCHMARK(iterate_vector, element_count)
+{
+    const auto c = make_filled<std::vector<position>>();
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        auto sum = 0.0f;
+
+        for (const auto& p : c)
+        {
+            sum += p.x;
+        }
+
+        aecs::bench::do_not_optimize(sum);
+    }
+
+    state.pause();
+}
+
+AECS_BENCHMARK(iterate_aligned_container, element_count)
+{
+    const auto c = make_filled<aecs::aligned_container<position>>();
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        auto sum = 0.0f;
+
+        for (const auto& p : c)
+        {
+            sum += p.x;
+        }
+
+        aecs::bench::do_not_optimize(sum);
+    }
+
+    state.pause();
+}
+
+AECS_BENCHMARK(iterate_chunked_container, element_count)
+{
+    const auto c = make_filled<aecs::chunked_container<position>>();
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        auto sum = 0.0f;
+
+        for (const auto& p : c)
+        {
+            sum += p.x;
+        }
+
+        aecs::bench::do_not_optimize(sum);
+    }
+
+    state.pause();
+}
+
+AECS_BENCHMARK(iterate_chunked_container_blocks, element_count)
+{
+    const auto c = make_filled<aecs::chunked_container<position>>();
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        auto sum = 0.0f;
+
+        for (std::size_t b = 0; b != c.block_count(); ++b)
+        {
+            const auto* data = c.block_data(b);
+
+            for (std::size_t i = 0; i != c.block_size(b); ++i)
+            {
+                sum += data[i].x;
+            }
+        }
+
+        aecs::bench::do_not_optimize(sum);
+    }
+
+    state.pause();
+}
+
+AECS_BENCHMARK(iterate_soa_container, element_count)
+{
+    const auto c = make_filled<aecs::soa_container<position>>();
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        auto sum = 0.0f;
+
+        for (auto x : c.member<0>())
+        {
+            sum += x;
+        }
+
+        aecs::bench::do_not_optimize(sum);
+    }
+
+    state.pause();
+}
+
+AECS_BENCHMARK(iterate_tag_container, element_count)
+{
+    auto c = aecs::tag_container<is_active>{};
+
+    for (std::size_t i = 0; i != element_count; ++i)
+    {
+        c.push_back(is_active{});
+    }
+
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        std::size_t count = 0;
+
+        for (const auto& t : c)
+        {
+            aecs::bench::do_not_optimize(t);
+            ++count;
+        }
+
+        aecs::bench::do_not_optimize(count);
+    }
+
+    state.pause();
+}
+
+AECS_BENCHMARK(iterate_bit_tag_container, element_count)
+{
+    auto c = aecs::bit_tag_container<is_active>{};
+
+    for (std::size_t i = 0; i != element_count; ++i)
+    {
+        // every other row enabled
+        c.push_back(i % 2 == 0);
+    }
+
+    state.resume();
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        std::size_t sum = 0;
+        c.for_each_set([&](std::size_t row) { sum += row; });
+        aecs::bench::do_not_optimize(sum);
+    }
+
+    state.pause();
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// define a benchmark processing items elements per iteration:
+//
+//   AECS_BENCHMARK(vector_push_back, 1)
+//   {
+//       ...
+//   }
+#define AECS_BENCHMARK(id, items)                                              \
+    static void id(::aecs::bench::state&);                                     \
+    static const ::aecs::bench::registrar id##_registrar{#id, items, id};      \
+    static void id(::aecs::bench::state& state)
+
+namespace aecs
+{
+namespace bench
+{
+// keep the compiler from optimizing away value or the computation of it.
+template<typename T>
+inline void do_not_optimize(const T& value) noexcept
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// hide where ptr came from, so calls through it can't be devirtualized.
+template<typename T>
+inline T* opaque(T* ptr) noexcept
+{
+    asm volatile("" : "+r"(ptr));
+    return ptr;
+}
+
+// force all pending writes to memory to be considered observable.
+inline void clobber() noexcept
+{
+    asm volatile("" : : : "memory");
+}
+
+// Passed to every benchmark, the benchmark runs its body iterations() times.
+// Setup which shouldn't be measured goes between pause and resume.
+class state
+{
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::size_t       iterations_;
+    clock::time_point start_{};
+    clock::duration   elapsed_{};
+
+public:
+    explicit state(std::size_t iterations) noexcept : iterations_{iterations}
+    {}
+
+    std::size_t iterations() const noexcept
+    {
+        return iterations_;
+    }
+
+    void pause() noexcept
+    {
+        elapsed_ += clock::now() - start_;
+    }
+
+    void resume() noexcept
+    {
+        start_ = clock::now();
+    }
+
+    // measured time in nanoseconds, only valid after the benchmark returned.
+    double elapsed_ns() const noexcept
+    {
+        return std::chrono::duration<double, std::nano>{elapsed_}.count();
+    }
+};
+
+struct benchmark
+{
+    const char* name;
+    // amount of items processed by a single iteration, used to report the
+    // time per item.
+    std::size_t items;
+    void (*fn)(state&);
+};
+
+inline std::vector<benchmark>& registry()
+{
+    static auto benchmarks = std::vector<benchmark>{};
+    return benchmarks;
+}
+
+struct registrar
+{
+    registrar(const char* name, std::size_t items, void (*fn)(state&))
+    {
+        registry().push_back(benchmark{name, items, fn});
+    }
+};
+} // namespace bench
+} // namespace aecs
\ No newline at end of file
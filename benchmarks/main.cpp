@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <ostream>
+#include <vector>
+
+#include "harness.hpp"
+
+namespace
+{
+struct result
+{
+    const aecs::bench::benchmark* bench;
+    std::size_t                   iterations;
+    double                        median_ns;
+    double                        min_ns;
+};
+
+double run_once(const aecs::bench::benchmark& b, std::size_t iterations)
+{
+    auto s = aecs::bench::state{iterations};
+    s.resume();
+    b.fn(s);
+    s.pause();
+    return s.elapsed_ns();
+}
+
+// double the iterations until a single run takes min_ns, then take samples
+// runs of that length.
+result run(const aecs::bench::benchmark& b, double min_ns, int samples)
+{
+    std::size_t iterations = 1;
+
+    while (run_once(b, iterations) < min_ns && iterations < (1u << 30))
+    {
+        iterations *= 2;
+    }
+
+    auto times = std::vector<double>{};
+
+    for (auto i = 0; i != samples; ++i)
+    {
+        times.push_back(run_once(b, iterations) /
+                        static_cast<double>(iterations));
+    }
+
+    std::sort(times.begin(), times.end());
+    return result{&b, iterations, times[times.size() / 2], times.front()};
+}
+
+void write_json(std::ostream& os, const std::vector<result>& results)
+{
+    os << "{\n  \"version\": \"" << AECS_VERSION << "\",\n"
+       << "  \"benchmarks\": [";
+
+    for (std::size_t i = 0; i != results.size(); ++i)
+    {
+        const auto& r     = results[i];
+        const auto  items = static_cast<double>(r.bench->items);
+
+        os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << r.bench->name
+           << "\", \"iterations\": " << r.iterations
+           << ", \"items\": " << r.bench->items
+           << ", \"ns_per_iteration\": " << r.median_ns
+           << ", \"min_ns_per_iteration\": " << r.min_ns
+           << ", \"ns_per_item\": " << r.median_ns / items << '}';
+    }
+
+    os << "\n  ]\n}\n";
+}
+} // namespace
+
+// usage: benchmarks [--out file.json] [--filter substring] [--samples n]
+int main(int argc, char** argv)
+{
+    const char* out     = nullptr;
+    const char* filter  = nullptr;
+    int         samples = 5;
+
+    for (auto i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        {
+            out = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+        {
+            samples = std::max(1, std::atoi(argv[++i]));
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    auto benchmarks = aecs::bench::registry();
+    std::sort(benchmarks.begin(),
+              benchmarks.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return std::strcmp(lhs.name, rhs.name) < 0;
+              });
+
+    auto results = std::vector<result>{};
+
+    for (const auto& b : benchmarks)
+    {
+        if (filter && std::strstr(b.name, filter) == nullptr)
+        {
+            continue;
+        }
+
+        results.push_back(run(b, 1e7, samples));
+        std::fprintf(stderr,
+                     "%-48s %12.2f ns/item\n",
+                     b.name,
+                     results.back().median_ns / static_cast<double>(b.items));
+    }
+
+    if (out)
+    {
+        auto file = std::ofstream{out};
+
+        if (!file)
+        {
+            std::fprintf(stderr, "can't open %s\n", out);
+            return 1;
+        }
+
+        write_json(file, results);
+    }
+    else
+    {
+        write_json(std::cout, results);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/wrapped.hpp"
+
+#include "harness.hpp"
+
+// The cost of the virtual polymorphic_container interface compared with
+// working on the container returned by get<T>().
+namespace
+{
+constexpr std::size_t element_count = std::size_t{1} << 14;
+
+struct position
+{
+    float x, y, z;
+};
+
+std::unique_ptr<aecs::polymorphic_container> make_column()
+{
+    return std::make_unique<aecs::wrapped_container<position>>();
+}
+
+void fill(aecs::polymorphic_container& col)
+{
+    auto& c = col.get<position>();
+
+    for (std::size_t i = 0; i != element_count; ++i)
+    {
+        c.push_back(position{float(i), 1, 2});
+    }
+}
+} // namespace
+
+AECS_BENCHMARK(polymorphic_push_back_virtual, element_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  owner = make_column();
+        auto* col   = aecs::bench::opaque(owner.get());
+        state.resume();
+
+        for (std::size_t i = 0; i != element_count; ++i)
+        {
+            col->push_back<position>(position{float(i), 1, 2});
+        }
+
+        aecs::bench::clobber();
+    }
+}
+
+AECS_BENCHMARK(polymorphic_push_back_direct, element_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  owner = make_column();
+        auto* col   = aecs::bench::opaque(owner.get());
+        state.resume();
+
+        auto& c = col->get<position>();
+
+        for (std::size_t i = 0; i != element_count; ++i)
+        {
+            c.push_back(position{float(i), 1, 2});
+        }
+
+        aecs::bench::clobber();
+    }
+}
+
+AECS_BENCHMARK(polymorphic_swap_pop_virtual, element_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  owner = make_column();
+        auto* col   = aecs::bench::opaque(owner.get());
+        fill(*col);
+        state.resume();
+
+        for (std::size_t i = 0; i != element_count; ++i)
+        {
+            col->swap_pop(0);
+        }
+
+        aecs::bench::clobber();
+    }
+}
+
+AECS_BENCHMARK(polymorphic_swap_pop_direct, element_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  owner = make_column();
+        auto* col   = aecs::bench::opaque(owner.get());
+        fill(*col);
+        state.resume();
+
+        auto& c = col->get<position>();
+
+        for (std::size_t i = 0; i != element_count; ++i)
+        {
+            using std::swap;
+            swap(c.front(), c.back());
+            c.pop_back();
+        }
+
+        aecs::bench::clobber();
+    }
+}
+
+// copy a whole column to a byte buffer, once through operator[] per element
+// and once per contiguous run.
+AECS_BENCHMARK(polymorphic_copy_out_per_element, element_count)
+{
+    auto  owner = make_column();
+    auto* col   = aecs::bench::opaque(owner.get());
+    fill(*col);
+
+    auto buffer = std::vector<unsigned char>(element_count * sizeof(position));
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        for (std::size_t i = 0; i != col->size(); ++i)
+        {
+            std::memcpy(buffer.data() + i * sizeof(position),
+                        (*col)[i].ptr(),
+                        sizeof(position));
+        }
+
+        aecs::bench::do_not_optimize(buffer.data());
+        aecs::bench::clobber();
+    }
+}
+
+AECS_BENCHMARK(polymorphic_copy_out_runs, element_count)
+{
+    auto  owner = make_column();
+    auto* col   = aecs::bench::opaque(owner.get());
+    fill(*col);
+
+    auto buffer = std::vector<unsigned char>(element_count * sizeof(position));
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        const auto size = col->element_size();
+
+        col->for_each_run([&](std::size_t first, void* data, std::size_t n) {
+            std::memcpy(buffer.data() + first * size, data, n * size);
+        });
+
+        aecs::bench::do_not_optimize(buffer.data());
+        aecs::bench::clobber();
+    }
+}
\ No newline at end of file
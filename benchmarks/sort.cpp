@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "aecs/utility/radix_sort.hpp"
+
+#include "harness.hpp"
+
+// Sorting row orders by 64 bit keys, the radix sort used by sort_rows
+// against std::stable_sort, and the incremental mode on mostly sorted keys.
+namespace
+{
+constexpr std::size_t key_count = std::size_t{1} << 16;
+
+std::vector<std::uint64_t> random_keys()
+{
+    auto rng  = std::mt19937_64{1};
+    auto keys = std::vector<std::uint64_t>(key_count);
+
+    for (auto& k : keys)
+    {
+        // 32 bits, like the morton code of two 16 bit coordinates
+        k = rng() & 0xffffffff;
+    }
+
+    return keys;
+}
+
+// sorted, apart from every 100th key
+std::vector<std::uint64_t> mostly_sorted_keys()
+{
+    auto keys = random_keys();
+    std::sort(keys.begin(), keys.end());
+
+    auto rng = std::mt19937_64{2};
+
+    for (std::size_t i = 0; i < key_count; i += 100)
+    {
+        keys[i] = rng() & 0xffffffff;
+    }
+
+    return keys;
+}
+} // namespace
+
+AECS_BENCHMARK(sort_order_stable_sort, key_count)
+{
+    const auto keys  = random_keys();
+    auto       order = std::vector<std::size_t>(key_count);
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        for (std::size_t i = 0; i != key_count; ++i)
+        {
+            order[i] = i;
+        }
+
+        std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+            return keys[lhs] < keys[rhs];
+        });
+
+        aecs::bench::do_not_optimize(order.data());
+    }
+}
+
+AECS_BENCHMARK(sort_order_radix, key_count)
+{
+    const auto keys  = random_keys();
+    auto       order = std::vector<std::size_t>{};
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        aecs::sort_order(keys.data(), keys.size(), order);
+        aecs::bench::do_not_optimize(order.data());
+    }
+}
+
+AECS_BENCHMARK(sort_order_mostly_sorted_full, key_count)
+{
+    const auto keys  = mostly_sorted_keys();
+    auto       order = std::vector<std::size_t>{};
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        aecs::sort_order(keys.data(), keys.size(), order);
+        aecs::bench::do_not_optimize(order.data());
+    }
+}
+
+AECS_BENCHMARK(sort_order_mostly_sorted_incremental, key_count)
+{
+    const auto keys  = mostly_sorted_keys();
+    auto       order = std::vector<std::size_t>{};
+
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        aecs::sort_order(
+            keys.data(), keys.size(), order, aecs::sort_mode::incremental);
+        aecs::bench::do_not_optimize(order.data());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/static_store.hpp"
+#include "aecs/container/wrapped.hpp"
+
+#include "harness.hpp"
+
+// Structural changes on a closed set of components, once on columns behind
+// the polymorphic_container vtable like an archetype stores them and once on
+// a static_store.
+namespace
+{
+constexpr std::size_t row_count = std::size_t{1} << 14;
+
+struct position
+{
+    float x, y, z;
+};
+
+struct velocity
+{
+    float x, y, z;
+};
+
+struct health
+{
+    int value;
+};
+
+using store_type = aecs::static_store<position, velocity, health>;
+
+using columns_type = std::vector<std::unique_ptr<aecs::polymorphic_container>>;
+
+columns_type make_columns()
+{
+    auto res = columns_type{};
+    res.push_back(std::make_unique<aecs::wrapped_container<position>>());
+    res.push_back(std::make_unique<aecs::wrapped_container<velocity>>());
+    res.push_back(std::make_unique<aecs::wrapped_container<health>>());
+    return res;
+}
+
+void fill(columns_type& cols)
+{
+    for (std::size_t i = 0; i != row_count; ++i)
+    {
+        cols[0]->push_back<position>(position{float(i), 1, 2});
+        cols[1]->push_back<velocity>(velocity{1, 1, 1});
+        cols[2]->push_back<health>(health{int(i)});
+    }
+}
+
+void fill(store_type& store)
+{
+    for (std::size_t i = 0; i != row_count; ++i)
+    {
+        store.push_back(
+            position{float(i), 1, 2}, velocity{1, 1, 1}, health{int(i)});
+    }
+}
+} // namespace
+
+// remove every row from the front, one swap_pop per row and column
+AECS_BENCHMARK(static_store_swap_pop_virtual, row_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  owner = make_columns();
+        auto* cols  = aecs::bench::opaque(&owner);
+        fill(*cols);
+        state.resume();
+
+        while ((*cols)[0]->size() != 0)
+        {
+            for (auto& col : *cols)
+            {
+                col->swap_pop(0);
+            }
+        }
+
+        aecs::bench::clobber();
+    }
+}
+
+AECS_BENCHMARK(static_store_swap_pop_static, row_count)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  owner = store_type{};
+        auto* store = aecs::bench::opaque(&owner);
+        fill(*store);
+        state.resume();
+
+        while (store->size() != 0)
+        {
+            store->swap_pop(0);
+        }
+
+        aecs::bench::clobber();
+    }
+}
+
+// move every other row to another table, one row at a time
+AECS_BENCHMARK(static_store_move_row_virtual, row_count / 2)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  src_owner = make_columns();
+        auto  dst_owner = make_columns();
+        auto* src       = aecs::bench::opaque(&src_owner);
+        auto* dst       = aecs::bench::opaque(&dst_owner);
+        fill(*src);
+        state.resume();
+
+        for (std::size_t row = 0; row < (*src)[0]->size(); ++row)
+        {
+            for (std::size_t c = 0; c != src->size(); ++c)
+            {
+                (*dst)[c]->push_back_from(*(*src)[c], row);
+                (*src)[c]->swap_pop(row);
+            }
+        }
+
+        aecs::bench::clobber();
+    }
+}
+
+AECS_BENCHMARK(static_store_move_row_static, row_count / 2)
+{
+    for (std::size_t it = 0; it != state.iterations(); ++it)
+    {
+        state.pause();
+        auto  src_owner = store_type{};
+        auto  dst_owner = store_type{};
+        auto* src       = aecs::bench::opaque(&src_owner);
+        auto* dst       = aecs::bench::opaque(&dst_owner);
+        fill(*src);
+        state.resume();
+
+        for (std::size_t row = 0; row < src->size(); ++row)
+        {
+            src->move_row(row, *dst);
+        }
+
+        aecs::bench::clobber();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef AECS_MAX_COMPONENTS
+#define AECS_MAX_COMPONENTS 256
+#endif
+
+namespace aecs
+{
+// the default amount of distinct components a component_mask can hold
+constexpr std::size_t max_components = AECS_MAX_COMPONENTS;
+
+// A fixed width set of dense component indices, see component_registry. All
+// set operations are a handful of word wise and/or operations.
+template<std::size_t Bits = max_components>
+class component_mask
+{
+    static_assert(Bits % 64 == 0, "Bits must be a multiple of 64");
+
+public:
+    static constexpr std::size_t word_count = Bits / 64;
+
+private:
+    std::array<std::uint64_t, word_count> words_{};
+
+public:
+    constexpr component_mask() noexcept = default;
+
+    static constexpr std::size_t size() noexcept
+    {
+        return Bits;
+    }
+
+    constexpr void set(std::size_t idx) noexcept
+    {
+        assert(idx < Bits);
+        words_[idx / 64] |= std::uint64_t{1} << (idx % 64);
+    }
+
+    constexpr void reset(std::size_t idx) noexcept
+    {
+        assert(idx < Bits);
+        words_[idx / 64] &= ~(std::uint64_t{1} << (idx % 64));
+    }
+
+    constexpr bool test(std::size_t idx) const noexcept
+    {
+        assert(idx < Bits);
+        return (words_[idx / 64] >> (idx % 64)) & 1;
+    }
+
+    constexpr bool none() const noexcept
+    {
+        for (auto w : words_)
+        {
+            if (w != 0)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    constexpr bool any() const noexcept
+    {
+        return !none();
+    }
+
+    // true if both masks share at least one bit
+    constexpr bool intersects(const component_mask& other) const noexcept
+    {
+        for (std::size_t i = 0; i != word_count; ++i)
+        {
+            if ((words_[i] & other.words_[i]) != 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // true if every bit of other is set in this
+    constexpr bool contains(const component_mask& other) const noexcept
+    {
+        for (std::size_t i = 0; i != word_count; ++i)
+        {
+            if ((words_[i] & other.words_[i]) != other.words_[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    constexpr std::uint64_t word(std::size_t idx) const noexcept
+    {
+        return words_[idx];
+    }
+
+    constexpr component_mask& operator|=(const component_mask& other) noexcept
+    {
+        for (std::size_t i = 0; i != word_count; ++i)
+        {
+            words_[i] |= other.words_[i];
+        }
+
+        return *this;
+    }
+
+    constexpr component_mask& operator&=(const component_mask& other) noexcept
+    {
+        for (std::size_t i = 0; i != word_count; ++i)
+        {
+            words_[i] &= other.words_[i];
+        }
+
+        return *this;
+    }
+
+    friend constexpr component_mask
+        operator|(component_mask lhs, const component_mask& rhs) noexcept
+    {
+        return lhs |= rhs;
+    }
+
+    friend constexpr component_mask
+        operator&(component_mask lhs, const component_mask& rhs) noexcept
+    {
+        return lhs &= rhs;
+    }
+
+    constexpr bool operator==(const component_mask& other) const noexcept
+    {
+        for (std::size_t i = 0; i != word_count; ++i)
+        {
+            if (words_[i] != other.words_[i])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    constexpr bool operator!=(const component_mask& other) const noexcept
+    {
+        return !(*this == other);
+    }
+};
+
+// The read, write and exclude sets of a constraint list as masks.
+template<std::size_t Bits = max_components>
+struct access_mask
+{
+    component_mask<Bits> read;
+    component_mask<Bits> write;
+    component_mask<Bits> exclude;
+
+    // components an archetype has to contain
+    constexpr component_mask<Bits> required() const noexcept
+    {
+        return read | write;
+    }
+
+    // true if the archetype with the passed components is iterated.
+    constexpr bool matches(const component_mask<Bits>& components) const
+        noexcept
+    {
+        return components.contains(required()) &&
+               !components.intersects(exclude);
+    }
+
+    // the rules of constraint_view::allow_parallelism. An exclude on a
+    // component the other accesses makes the entity sets disjoint, otherwise
+    // any component written by one and accessed by the other conflicts.
+    constexpr bool allow_parallelism(const access_mask& other) const noexcept
+    {
+        if (exclude.intersects(other.required()) ||
+            other.exclude.intersects(required()))
+        {
+            return true;
+        }
+
+        return !write.intersects(other.required()) &&
+               !other.write.intersects(read);
+    }
+};
+} // namespace aecs
\ No newline at end of file
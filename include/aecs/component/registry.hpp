@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "aecs/component/mask.hpp"
+#include "aecs/entity/constraint.hpp"
+
+namespace aecs
+{
+// Assigns every component hash a small dense index in the order they're first
+// seen, these are the bit positions used by component_mask.
+template<std::size_t Bits = max_components>
+class basic_component_registry
+{
+public:
+    using mask_type        = aecs::component_mask<Bits>;
+    using access_mask_type = aecs::access_mask<Bits>;
+
+    static constexpr std::uint32_t invalid_index = ~std::uint32_t{0};
+
+private:
+    std::unordered_map<std::size_t, std::uint32_t> indices_;
+
+public:
+    basic_component_registry() = default;
+
+    // amount of registered components
+    std::size_t size() const noexcept
+    {
+        return indices_.size();
+    }
+
+    // the index of hash, registering it if it's new. Throws
+    // std::length_error once more than Bits components would be registered,
+    // as their indices wouldn't fit in a mask.
+    std::uint32_t index(std::size_t hash)
+    {
+        const auto next = static_cast<std::uint32_t>(indices_.size());
+
+        if (auto it = indices_.find(hash); it != indices_.end())
+        {
+            return it->second;
+        }
+
+        if (next == Bits)
+        {
+            throw std::length_error{
+                "too many components, raise AECS_MAX_COMPONENTS"};
+        }
+
+        indices_.emplace(hash, next);
+        return next;
+    }
+
+    // the index of hash or invalid_index if it was never registered.
+    std::uint32_t find(std::size_t hash) const noexcept
+    {
+        auto it = indices_.find(hash);
+        return it != indices_.end() ? it->second : invalid_index;
+    }
+
+    template<typename It>
+    mask_type make_mask(It first, It last)
+    {
+        auto res = mask_type{};
+
+        for (; first != last; ++first)
+        {
+            res.set(index(*first));
+        }
+
+        return res;
+    }
+
+    // register every component of cs.
+    void add(aecs::entity::constraint_view cs)
+    {
+        for (const auto& c : cs)
+        {
+            index(c.hash());
+        }
+    }
+
+    access_mask_type make_access_mask(aecs::entity::constraint_view cs)
+    {
+        add(cs);
+        return *find_access_mask(cs);
+    }
+
+    // the access_mask of cs without registering anything, so other threads
+    // may do the same concurrently. A component which was never registered
+    // isn't part of any archetype, excluding it excludes nothing and reading
+    // or writing it matches nothing, for which nullopt is returned.
+    std::optional<access_mask_type>
+        find_access_mask(aecs::entity::constraint_view cs) const
+    {
+        auto res = access_mask_type{};
+
+        for (const auto& c : cs)
+        {
+            const auto idx = find(c.hash());
+
+            if (idx == invalid_index)
+            {
+                if (c.access() == aecs::entity::access::exclude)
+                {
+                    continue;
+                }
+
+                return std::nullopt;
+            }
+
+            switch (c.access())
+            {
+            case aecs::entity::access::exclude:
+                res.exclude.set(idx);
+                break;
+            case aecs::entity::access::write:
+                res.write.set(idx);
+                break;
+            case aecs::entity::access::read:
+                res.read.set(idx);
+                break;
+            }
+        }
+
+        return res;
+    }
+};
+
+using component_registry = basic_component_registry<>;
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "aecs/component/type.hpp"
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/wrapped.hpp"
+#include "aecs/utility/perfect_hash.hpp"
+
+namespace aecs
+{
+// A set of component types known at compile time. Component hashes are
+// mapped to the position of their type in Ts through a perfect_hash, so no
+// runtime hash map is involved.
+template<typename... Ts>
+struct component_set
+{
+    static constexpr std::size_t size = sizeof...(Ts);
+    static constexpr std::size_t npos = aecs::perfect_hash<size>::npos;
+
+    static constexpr auto table = aecs::perfect_hash<size>{
+        std::array<std::uint64_t, size>{aecs::component_type<Ts>::hash()...}};
+
+    // position of the component with hash in Ts, or npos.
+    static constexpr std::size_t index(std::size_t hash) noexcept
+    {
+        return table.find(hash);
+    }
+
+    template<typename T>
+    static constexpr std::size_t index() noexcept
+    {
+        constexpr auto res = index(aecs::component_type<T>::hash());
+        return res;
+    }
+
+    static constexpr bool contains(std::size_t hash) noexcept
+    {
+        return table.contains(hash);
+    }
+
+    // call fn with the wrapped_container col actually is. Returns false
+    // without calling fn if the component of col isn't part of the set.
+    template<typename F>
+    static bool visit(aecs::polymorphic_container& col, F&& fn)
+    {
+        return visit_impl(col,
+                          index(col.component_hash()),
+                          fn,
+                          std::index_sequence_for<Ts...>{});
+    }
+
+    template<typename F>
+    static bool visit(const aecs::polymorphic_container& col, F&& fn)
+    {
+        return visit_impl(col,
+                          index(col.component_hash()),
+                          fn,
+                          std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    // wrapped_container<T> with the constness of C
+    template<typename C, typename T>
+    using wrapped_like = std::conditional_t<std::is_const_v<C>,
+                                            const aecs::wrapped_container<T>,
+                                            aecs::wrapped_container<T>>;
+
+    template<typename C, typename F, std::size_t... Is>
+    static bool
+        visit_impl(C& col, std::size_t idx, F& fn, std::index_sequence<Is...>)
+    {
+        return ((idx == Is &&
+                 (assert(col.template is_wrapped<Ts>() &&
+                         "This is the wrong component type"),
+                  fn(static_cast<wrapped_like<C, Ts>&>(col)),
+                  true)) ||
+                ...);
+    }
+};
+} // namespace aecs
\ No newline at end of file
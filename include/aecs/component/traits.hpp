@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+
 #include "aecs/component/type.hpp"
 
 namespace aecs
@@ -7,4 +10,13 @@ namespace aecs
 template<typename T>
 using component_container_t =
     decltype(aecs::component_type<T>::make_container());
+
+// how often T occurs in Ts
+template<typename T, typename... Ts>
+inline constexpr std::size_t type_count_v =
+    (std::size_t{std::is_same_v<T, Ts>} + ... + 0);
+
+// true if no type occurs twice in Ts
+template<typename... Ts>
+inline constexpr bool unique_types_v = ((type_count_v<Ts, Ts...> == 1) && ...);
 }
\ No newline at end of file
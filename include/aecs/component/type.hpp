@@ -1,10 +1,13 @@
 #pragma once
 
+#include <string_view>
+#include <vector>
+
 #include "aecs/component/concepts.hpp"
 #include "aecs/container/tag.hpp"
+#include "aecs/utility/name_hash.hpp"
 #include "aecs/utility/nameof_type.hpp"
 #include "aecs/utility/priority_tag.hpp"
-#include "aecs/utility/sha1.hpp"
 
 namespace aecs
 {
@@ -87,7 +90,7 @@ struct component_hash_fn
     constexpr auto operator()(aecs::component_type<T>) const noexcept
     {
         constexpr auto n    = aecs::component_type<T>::name();
-        constexpr auto hash = aecs::sha1(n);
+        constexpr auto hash = aecs::name_hash(n);
         return hash;
     }
 };
@@ -0,0 +1,386 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// Bulk operations over component containers. All components are trivially
+// copyable, so wherever the container exposes contiguous storage elements are
+// moved around with memcpy instead of one at a time.
+namespace aecs
+{
+namespace detail
+{
+template<typename C, typename = void>
+struct has_data : std::false_type
+{};
+
+template<typename C>
+struct has_data<C,
+                std::enable_if_t<std::is_pointer_v<
+                    decltype(std::declval<C&>().data())>>> : std::true_type
+{};
+
+template<typename C>
+inline constexpr bool has_data_v = has_data<C>::value;
+
+template<typename C, typename = void>
+struct has_range_insert : std::false_type
+{};
+
+template<typename C>
+struct has_range_insert<
+    C,
+    std::void_t<decltype(std::declval<C&>().insert(
+        std::declval<C&>().end(),
+        std::declval<const typename C::value_type*>(),
+        std::declval<const typename C::value_type*>()))>> : std::true_type
+{};
+
+template<typename C>
+inline constexpr bool has_range_insert_v = has_range_insert<C>::value;
+
+template<typename C, typename = void>
+struct has_range_erase : std::false_type
+{};
+
+template<typename C>
+struct has_range_erase<C,
+                       std::void_t<decltype(std::declval<C&>().erase(
+                           std::declval<C&>().begin(),
+                           std::declval<C&>().end()))>> : std::true_type
+{};
+
+template<typename C>
+inline constexpr bool has_range_erase_v = has_range_erase<C>::value;
+
+template<typename C, typename = void>
+struct has_append : std::false_type
+{};
+
+template<typename C>
+struct has_append<C,
+                  std::void_t<decltype(std::declval<C&>().append(
+                      std::declval<const typename C::value_type*>(),
+                      std::size_t{}))>> : std::true_type
+{};
+
+template<typename C>
+inline constexpr bool has_append_v = has_append<C>::value;
+
+template<typename C, typename = void>
+struct has_block_data : std::false_type
+{};
+
+template<typename C>
+struct has_block_data<
+    C,
+    std::void_t<decltype(std::declval<const C&>().block_data(std::size_t{})),
+                decltype(C::elements_per_block)>> : std::true_type
+{};
+
+template<typename C>
+inline constexpr bool has_block_data_v = has_block_data<C>::value;
+
+template<typename C, typename = void>
+struct has_append_bits : std::false_type
+{};
+
+template<typename C>
+struct has_append_bits<
+    C,
+    std::void_t<decltype(std::declval<const C&>().words()),
+                decltype(std::declval<C&>().append_bits(
+                    std::declval<const std::uint64_t*>(), std::size_t{}))>>
+    : std::true_type
+{};
+
+template<typename C>
+inline constexpr bool has_append_bits_v = has_append_bits<C>::value;
+
+// append count elements starting at first to c.
+template<typename C, typename T>
+void append_n(C& c, const T* first, std::size_t count)
+{
+    if constexpr (has_append_v<C>)
+    {
+        c.append(first, count);
+    }
+    else if constexpr (has_range_insert_v<C>)
+    {
+        // std::vector turns this into a memcpy for trivially copyable types
+        c.insert(c.end(), first, first + count);
+    }
+    else
+    {
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            c.push_back(first[i]);
+        }
+    }
+}
+
+// append the count elements of src starting at first to dst. Is split in
+// contiguous runs when the source has any.
+template<typename C>
+void append_range(C& dst, const C& src, std::size_t first, std::size_t count)
+{
+    assert(first + count <= src.size());
+
+    if constexpr (has_data_v<const C>)
+    {
+        append_n(dst, src.data() + first, count);
+    }
+    else if constexpr (has_block_data_v<C>)
+    {
+        constexpr auto per_block = C::elements_per_block;
+
+        while (count != 0)
+        {
+            const auto offset = first % per_block;
+            const auto len    = std::min(count, per_block - offset);
+            append_n(dst, src.block_data(first / per_block) + offset, len);
+            first += len;
+            count -= len;
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            dst.push_back(src[first + i]);
+        }
+    }
+}
+
+// append the elements at the count indices to dst. Consecutive indices are
+// copied as a single run.
+template<typename C>
+void append_rows(C&                 dst,
+                 const C&           src,
+                 const std::size_t* indices,
+                 std::size_t        count)
+{
+    std::size_t i = 0;
+
+    while (i != count)
+    {
+        auto run = std::size_t{1};
+
+        while (i + run != count && indices[i + run] == indices[i] + run)
+        {
+            ++run;
+        }
+
+        append_range(dst, src, indices[i], run);
+        i += run;
+    }
+}
+
+// The raw representation of the elements of a container of T, used to write
+// a column as plain bytes and read it back. Elements are stored as an array
+// of T, bit packed containers store their words and empty tags take no space.
+
+// amount of bytes the raw representation of count elements takes.
+template<typename T, typename C>
+std::size_t raw_size(std::size_t count) noexcept
+{
+    if constexpr (has_append_bits_v<C>)
+    {
+        return (count + 63) / 64 * sizeof(std::uint64_t);
+    }
+    else if constexpr (std::is_empty_v<T>)
+    {
+        return 0;
+    }
+    else
+    {
+        return count * sizeof(T);
+    }
+}
+
+// write the raw representation of all elements of c to dst.
+template<typename T, typename C>
+void copy_raw(const C& c, void* dst)
+{
+    auto* out = static_cast<unsigned char*>(dst);
+
+    if (c.size() == 0)
+    {
+        return;
+    }
+
+    if constexpr (has_append_bits_v<C>)
+    {
+        std::memcpy(out, c.words(), raw_size<T, C>(c.size()));
+    }
+    else if constexpr (std::is_empty_v<T>)
+    {}
+    else if constexpr (has_data_v<const C>)
+    {
+        std::memcpy(out, c.data(), c.size() * sizeof(T));
+    }
+    else if constexpr (has_block_data_v<C>)
+    {
+        for (std::size_t b = 0; b != c.block_count(); ++b)
+        {
+            const auto len = c.block_size(b) * sizeof(T);
+            std::memcpy(out, c.block_data(b), len);
+            out += len;
+        }
+    }
+    else
+    {
+        // proxy containers, such as soa_container
+        for (std::size_t i = 0; i != c.size(); ++i)
+        {
+            const auto value = static_cast<T>(c[i]);
+            std::memcpy(out + i * sizeof(T), &value, sizeof(T));
+        }
+    }
+}
+
+// append count elements from the raw representation at src to c.
+template<typename T, typename C>
+void append_raw(C& c, const void* src, std::size_t count)
+{
+    if constexpr (has_append_bits_v<C>)
+    {
+        c.append_bits(static_cast<const std::uint64_t*>(src), count);
+    }
+    else if constexpr (std::is_empty_v<T>)
+    {
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            c.push_back(T{});
+        }
+    }
+    else
+    {
+        append_n(c, static_cast<const T*>(src), count);
+    }
+}
+
+// Contiguous runs of the elements of a container of T, for type erased access
+// to the storage. Only containers storing actual T objects have runs, bit
+// packed tags, proxy containers and empty tags have none.
+template<typename T, typename C>
+inline constexpr bool has_runs_v =
+    !std::is_empty_v<T> && !has_append_bits_v<C> &&
+    (has_data_v<C> || has_block_data_v<C>);
+
+template<typename T, typename C>
+std::size_t run_count(const C& c) noexcept
+{
+    if constexpr (!has_runs_v<T, C>)
+    {
+        return 0;
+    }
+    else if constexpr (has_data_v<C>)
+    {
+        return c.size() == 0 ? 0 : 1;
+    }
+    else
+    {
+        // unused blocks past the end aren't runs
+        constexpr auto per_block = C::elements_per_block;
+        return (c.size() + per_block - 1) / per_block;
+    }
+}
+
+// the first element of run r and the amount of elements in it, a pointer to
+// const if c is const.
+template<typename T, typename C>
+std::pair<std::conditional_t<std::is_const_v<C>, const T*, T*>, std::size_t>
+    run(C& c, std::size_t r) noexcept
+{
+    static_assert(has_runs_v<T, C>, "C has no contiguous runs");
+    assert(r < run_count<T>(c));
+
+    if constexpr (has_data_v<C>)
+    {
+        return {c.data(), c.size()};
+    }
+    else
+    {
+        return {c.block_data(r), c.block_size(r)};
+    }
+}
+
+// shrink c down to size n
+template<typename C>
+void truncate(C& c, std::size_t n)
+{
+    assert(n <= c.size());
+
+    if constexpr (has_range_erase_v<C>)
+    {
+        c.erase(c.begin() + n, c.end());
+    }
+    else
+    {
+        while (c.size() != n)
+        {
+            c.pop_back();
+        }
+    }
+}
+
+// remove the elements at the count ascending, unique indices. The result is
+// identical to calling swap_pop for every index from the highest to the
+// lowest, so the same removal can be replayed on other columns.
+template<typename C>
+void swap_pop_sorted(C& c, const std::size_t* indices, std::size_t count)
+{
+    auto size = c.size();
+    auto i    = count;
+
+    while (i != 0)
+    {
+        // find the run of consecutive indices ending at i - 1
+        auto run = std::size_t{1};
+
+        while (run != i && indices[i - 1 - run] + run == indices[i - 1])
+        {
+            ++run;
+        }
+
+        const auto first = indices[i - run];
+        assert(first + run <= size && "indices must be sorted and unique");
+
+        if constexpr (has_data_v<C>)
+        {
+            // all elements after the run are kept, so if the tail doesn't
+            // overlap the run it can be copied over in one go.
+            if (first + run <= size - run)
+            {
+                std::memcpy(c.data() + first,
+                            c.data() + size - run,
+                            run * sizeof(*c.data()));
+                size -= run;
+                i -= run;
+                continue;
+            }
+        }
+
+        for (auto idx = first + run; idx != first; --idx)
+        {
+            if (idx != size)
+            {
+                c[idx - 1] = c[size - 1];
+            }
+
+            --size;
+        }
+
+        i -= run;
+    }
+
+    truncate(c, size);
+}
+} // namespace detail
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "aecs/component/concepts.hpp"
+
+namespace aecs
+{
+namespace detail
+{
+constexpr std::size_t gcd(std::size_t a, std::size_t b) noexcept
+{
+    while (b != 0)
+    {
+        auto t = a % b;
+        a      = b;
+        b      = t;
+    }
+
+    return a;
+}
+} // namespace detail
+
+// A vector like container for SIMD kernels. Element 0 is aligned to Align
+// bytes and the storage is always a whole number of Align sized registers.
+//
+// Every element between size() and padded_size() is kept zero filled, so a
+// kernel can process the full padded range without a remainder loop.
+template<typename T, std::size_t Align = 64>
+class aligned_container
+{
+    static_assert(std::is_same_v<T, std::remove_cv_t<T>>,
+                  "type cannot be const/volatile qualified");
+    static_assert(aecs::is_component_v<T>,
+                  "aligned_container only stores trivially copyable types");
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of 2");
+    static_assert(Align >= alignof(T), "Align is weaker than alignof(T)");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+
+    static constexpr size_type alignment = Align;
+
+    // the smallest amount of elements which fill a whole number of registers
+    static constexpr size_type padding_granularity =
+        Align / detail::gcd(Align, sizeof(T));
+
+private:
+    T*        data_{nullptr};
+    size_type size_{};
+    size_type capacity_{};
+
+public:
+    aligned_container() = default;
+
+    aligned_container(const aligned_container& other)
+    {
+        if (other.size_ != 0)
+        {
+            reserve(other.size_);
+            std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+            size_ = other.size_;
+        }
+    }
+
+    aligned_container(aligned_container&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)},
+          capacity_{std::exchange(other.capacity_, 0)}
+    {}
+
+    aligned_container& operator=(const aligned_container& other)
+    {
+        auto copy = other;
+        swap(copy);
+        return *this;
+    }
+
+    aligned_container& operator=(aligned_container&& other) noexcept
+    {
+        auto moved = std::move(other);
+        swap(moved);
+        return *this;
+    }
+
+    ~aligned_container()
+    {
+        deallocate(data_);
+    }
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    // size rounded up to a whole number of registers, the elements past
+    // size() are zero.
+    size_type padded_size() const noexcept
+    {
+        return round_up(size_);
+    }
+
+    T* data() noexcept
+    {
+        return data_;
+    }
+
+    const T* data() const noexcept
+    {
+        return data_;
+    }
+
+    iterator begin() noexcept
+    {
+        return data_;
+    }
+
+    iterator end() noexcept
+    {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    reference operator[](size_type idx) noexcept
+    {
+        assert(idx < size());
+        return data_[idx];
+    }
+
+    const_reference operator[](size_type idx) const noexcept
+    {
+        assert(idx < size());
+        return data_[idx];
+    }
+
+    reference front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    reference back() noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+    const_reference back() const noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+    void reserve(size_type n)
+    {
+        if (n <= capacity_)
+        {
+            return;
+        }
+
+        const auto new_capacity = round_up(n);
+        auto*      new_data     = allocate(new_capacity);
+
+        if (size_ != 0)
+        {
+            std::memcpy(new_data, data_, size_ * sizeof(T));
+        }
+
+        std::memset(static_cast<void*>(new_data + size_),
+                    0,
+                    (new_capacity - size_) * sizeof(T));
+
+        deallocate(data_);
+        data_     = new_data;
+        capacity_ = new_capacity;
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        grow_for(size_ + 1);
+        auto* res = ::new (static_cast<void*>(data_ + size_))
+            T(std::forward<Args>(args)...);
+        ++size_;
+        return *res;
+    }
+
+    void push_back(const T& t)
+    {
+        emplace_back(t);
+    }
+
+    void push_back(T&& t)
+    {
+        emplace_back(std::move(t));
+    }
+
+    // append count elements starting at first with a single memcpy.
+    void append(const T* first, size_type count)
+    {
+        grow_for(size_ + count);
+        std::memcpy(
+            static_cast<void*>(data_ + size_), first, count * sizeof(T));
+        size_ += count;
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty());
+        --size_;
+        zero(size_, 1);
+    }
+
+    // remove idx by moving the last element into its place.
+    void swap_pop(size_type idx) noexcept
+    {
+        assert(idx < size());
+
+        if (idx != size_ - 1)
+        {
+            data_[idx] = back();
+        }
+
+        pop_back();
+    }
+
+    // shrinking zeroes the removed elements, growing value initializes.
+    void resize(size_type n)
+    {
+        if (n < size_)
+        {
+            zero(n, size_ - n);
+        }
+        else
+        {
+            grow_for(n);
+
+            for (auto i = size_; i != n; ++i)
+            {
+                ::new (static_cast<void*>(data_ + i)) T{};
+            }
+        }
+
+        size_ = n;
+    }
+
+    void clear() noexcept
+    {
+        zero(0, size_);
+        size_ = 0;
+    }
+
+    void swap(aligned_container& other) noexcept
+    {
+        using std::swap;
+        swap(data_, other.data_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+    }
+
+private:
+    static constexpr size_type round_up(size_type n) noexcept
+    {
+        return (n + padding_granularity - 1) / padding_granularity *
+               padding_granularity;
+    }
+
+    static T* allocate(size_type n)
+    {
+        return static_cast<T*>(
+            ::operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    static void deallocate(T* ptr) noexcept
+    {
+        if (ptr)
+        {
+            ::operator delete(ptr, std::align_val_t{Align});
+        }
+    }
+
+    void grow_for(size_type n)
+    {
+        if (n > capacity_)
+        {
+            reserve(std::max(n, capacity_ * 2));
+        }
+    }
+
+    void zero(size_type first, size_type count) noexcept
+    {
+        std::memset(static_cast<void*>(data_ + first), 0, count * sizeof(T));
+    }
+};
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,512 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aecs/component/traits.hpp"
+#include "aecs/component/type.hpp"
+#include "aecs/container/algorithm.hpp"
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/wrapped.hpp"
+#include "aecs/entity/id.hpp"
+
+namespace aecs
+{
+// A table of component columns which all belong to the same entities. Every
+// column has the same length and row i of each column describes the same
+// entity, the entity ids themselves are stored in an additional column.
+//
+// Columns are kept sorted by their component hash, the sorted list of hashes
+// is the signature of the archetype.
+//
+// Every column keeps a change version per chunk of chunk_rows rows. The
+// archetype itself never bumps them, that's up to whoever writes, see
+// world::version. Chunks which were never marked have version 0.
+class archetype
+{
+private:
+    std::vector<std::size_t>                            hashes_;
+    std::vector<std::unique_ptr<polymorphic_container>> columns_;
+    std::vector<aecs::entity::id>                       entities_;
+    // versions_[column][chunk]
+    std::vector<std::vector<std::uint64_t>>             versions_;
+
+public:
+    // rows are iterated in chunks of this many rows. A multiple of 64 so the
+    // chunks of any column start on a cache line if element 0 does.
+    static constexpr std::size_t chunk_rows = 4096;
+
+    archetype() = default;
+
+    template<typename... Ts>
+    explicit archetype(std::in_place_type_t<Ts>...)
+        : archetype{[]() {
+              auto cols = std::vector<std::unique_ptr<polymorphic_container>>{};
+              cols.reserve(sizeof...(Ts));
+              (cols.push_back(std::make_unique<aecs::wrapped_container<Ts>>()),
+               ...);
+              return cols;
+          }()}
+    {}
+
+    // takes ownership of empty columns, the order they're passed in does not
+    // matter.
+    explicit archetype(
+        std::vector<std::unique_ptr<polymorphic_container>> columns)
+        : columns_{std::move(columns)}
+    {
+        std::sort(columns_.begin(),
+                  columns_.end(),
+                  [](const auto& lhs, const auto& rhs) {
+                      return lhs->component_hash() < rhs->component_hash();
+                  });
+
+        hashes_.reserve(columns_.size());
+
+        for (const auto& col : columns_)
+        {
+            assert(col->size() == 0 && "columns must be empty");
+            assert((hashes_.empty() ||
+                    hashes_.back() != col->component_hash()) &&
+                   "component types must be unique");
+            hashes_.push_back(col->component_hash());
+        }
+
+        versions_.resize(columns_.size());
+    }
+
+    archetype(archetype&&) = default;
+    archetype& operator=(archetype&&) = default;
+
+    // return an empty archetype with the same columns.
+    archetype replicate() const
+    {
+        return archetype{replicate_columns()};
+    }
+
+    // return an empty archetype with the same columns and col added.
+    archetype extend(std::unique_ptr<polymorphic_container> col) const
+    {
+        assert(!has_component(col->component_hash()) &&
+               "component is already part of this archetype");
+        auto cols = replicate_columns();
+        cols.push_back(std::move(col));
+        return archetype{std::move(cols)};
+    }
+
+    template<typename T>
+    archetype extend() const
+    {
+        return extend(std::make_unique<aecs::wrapped_container<T>>());
+    }
+
+    // return an empty archetype with the same columns, except hash.
+    archetype reduce(std::size_t hash) const
+    {
+        assert(has_component(hash) &&
+               "component is not part of this archetype");
+        auto cols = std::vector<std::unique_ptr<polymorphic_container>>{};
+        cols.reserve(columns_.size() - 1);
+
+        for (const auto& col : columns_)
+        {
+            if (col->component_hash() != hash)
+            {
+                cols.push_back(col->replicate());
+            }
+        }
+
+        return archetype{std::move(cols)};
+    }
+
+    template<typename T>
+    archetype reduce() const
+    {
+        return reduce(aecs::component_type<T>::hash());
+    }
+
+    // number of rows
+    std::size_t size() const noexcept
+    {
+        return entities_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return entities_.empty();
+    }
+
+    // number of chunk_rows sized chunks, the last one may be partial.
+    std::size_t chunk_count() const noexcept
+    {
+        return (size() + chunk_rows - 1) / chunk_rows;
+    }
+
+    // the version chunk of column was last marked with.
+    std::uint64_t version(std::size_t column, std::size_t chunk) const noexcept
+    {
+        assert(column < column_count() && chunk < chunk_count());
+        return versions_[column][chunk];
+    }
+
+    bool changed_since(std::size_t   column,
+                       std::size_t   chunk,
+                       std::uint64_t since) const noexcept
+    {
+        return version(column, chunk) > since;
+    }
+
+    // Only touches the version of this chunk, so different chunks can be
+    // marked concurrently.
+    void mark_changed(std::size_t   column,
+                      std::size_t   chunk,
+                      std::uint64_t version) noexcept
+    {
+        assert(column < column_count() && chunk < chunk_count());
+        versions_[column][chunk] = version;
+    }
+
+    // mark the chunk containing row in every column.
+    void mark_row_changed(std::size_t row, std::uint64_t version) noexcept
+    {
+        assert(row < size());
+
+        for (auto& col : versions_)
+        {
+            col[row / chunk_rows] = version;
+        }
+    }
+
+    // mark the chunks of rows [first, last) in every column.
+    void mark_rows_changed(std::size_t   first,
+                           std::size_t   last,
+                           std::uint64_t version) noexcept
+    {
+        assert(first <= last && last <= size());
+
+        if (first == last)
+        {
+            return;
+        }
+
+        for (auto& col : versions_)
+        {
+            for (auto c = first / chunk_rows; c <= (last - 1) / chunk_rows; ++c)
+            {
+                col[c] = version;
+            }
+        }
+    }
+
+    // the entity stored in each row
+    const std::vector<aecs::entity::id>& entities() const noexcept
+    {
+        return entities_;
+    }
+
+    std::size_t column_count() const noexcept
+    {
+        return columns_.size();
+    }
+
+    // sorted component hashes, in the same order as the columns.
+    const std::vector<std::size_t>& hashes() const noexcept
+    {
+        return hashes_;
+    }
+
+    polymorphic_container& column(std::size_t idx) noexcept
+    {
+        assert(idx < column_count());
+        return *columns_[idx];
+    }
+
+    const polymorphic_container& column(std::size_t idx) const noexcept
+    {
+        assert(idx < column_count());
+        return *columns_[idx];
+    }
+
+    // index of the column storing hash, or column_count() if not found.
+    std::size_t column_index(std::size_t hash) const noexcept
+    {
+        auto it = std::lower_bound(hashes_.begin(), hashes_.end(), hash);
+
+        if (it == hashes_.end() || *it != hash)
+        {
+            return column_count();
+        }
+
+        return static_cast<std::size_t>(it - hashes_.begin());
+    }
+
+    bool has_component(std::size_t hash) const noexcept
+    {
+        return column_index(hash) != column_count();
+    }
+
+    template<typename T>
+    bool has_component() const noexcept
+    {
+        return has_component(aecs::component_type<T>::hash());
+    }
+
+    polymorphic_container* find(std::size_t hash) noexcept
+    {
+        auto idx = column_index(hash);
+        return idx == column_count() ? nullptr : columns_[idx].get();
+    }
+
+    const polymorphic_container* find(std::size_t hash) const noexcept
+    {
+        auto idx = column_index(hash);
+        return idx == column_count() ? nullptr : columns_[idx].get();
+    }
+
+    template<typename T>
+    aecs::component_container_t<T>& get() noexcept
+    {
+        auto* col = find(aecs::component_type<T>::hash());
+        assert(col && "component is not part of this archetype");
+        return col->template get<T>();
+    }
+
+    template<typename T>
+    const aecs::component_container_t<T>& get() const noexcept
+    {
+        const auto* col = find(aecs::component_type<T>::hash());
+        assert(col && "component is not part of this archetype");
+        return col->template get<T>();
+    }
+
+    // append a row for e, a value for every column has to be provided.
+    // Returns the index of the new row.
+    template<typename... Ts>
+    std::size_t push_back(aecs::entity::id e, Ts&&... values)
+    {
+        static_assert(aecs::unique_types_v<
+                          std::remove_cv_t<std::remove_reference_t<Ts>>...>,
+                      "a value can only be provided once per column");
+        assert(sizeof...(Ts) == column_count() &&
+               "a value is required for every column");
+
+        (push_column_value(std::forward<Ts>(values)), ...);
+        entities_.push_back(e);
+        fit_versions();
+        return entities_.size() - 1;
+    }
+
+    // append every row of src, which must have the same columns, the new
+    // rows store the entities ids. Returns the index of the first new row.
+    std::size_t append(const archetype& src, const aecs::entity::id* ids)
+    {
+        assert(src.hashes() == hashes_ && "archetypes must have equal columns");
+
+        const auto first = size();
+        const auto count = src.size();
+
+        auto rows = std::vector<std::size_t>(count);
+        std::iota(rows.begin(), rows.end(), std::size_t{0});
+
+        for (std::size_t i = 0; i != column_count(); ++i)
+        {
+            src.columns_[i]->copy_rows_to(*columns_[i], rows.data(), count);
+        }
+
+        entities_.insert(entities_.end(), ids, ids + count);
+        fit_versions();
+        return first;
+    }
+
+    // append count rows for ids from raw column data, columns[i] is read by
+    // column(i).append_raw. Returns the index of the first new row.
+    std::size_t append_raw(const void* const*      columns,
+                           const aecs::entity::id* ids,
+                           std::size_t             count)
+    {
+        const auto first = size();
+
+        for (std::size_t i = 0; i != column_count(); ++i)
+        {
+            columns_[i]->append_raw(columns[i], count);
+        }
+
+        entities_.insert(entities_.end(), ids, ids + count);
+        fit_versions();
+        return first;
+    }
+
+    // remove row idx by moving the last row into its place, in every column.
+    // Afterwards entities()[idx] is the entity which got moved, if any.
+    void swap_pop(std::size_t idx)
+    {
+        assert(idx < size());
+
+        for (auto& col : columns_)
+        {
+            col->swap_pop(idx);
+        }
+
+        entities_[idx] = entities_.back();
+        entities_.pop_back();
+        fit_versions();
+    }
+
+    // remove the rows at the count ascending indices from every column, see
+    // polymorphic_container::swap_pop_sorted.
+    void swap_pop_sorted(const std::size_t* indices, std::size_t count)
+    {
+        assert(count <= size());
+
+        for (auto& col : columns_)
+        {
+            col->swap_pop_sorted(indices, count);
+        }
+
+        detail::swap_pop_sorted(entities_, indices, count);
+        fit_versions();
+    }
+
+    // reorder the rows, row i becomes the row previously at order[i] in every
+    // column. order must be a permutation of [0, size()). Versions are left
+    // alone, marking the rows is up to the caller.
+    void permute(const std::size_t* order)
+    {
+        for (auto& col : columns_)
+        {
+            col->permute(order);
+        }
+
+        auto ids = std::vector<aecs::entity::id>(size());
+
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            ids[i] = entities_[order[i]];
+        }
+
+        entities_ = std::move(ids);
+    }
+
+    // the bulk version of move_row, indices must be ascending. The rows are
+    // appended to dst in the order of indices, returns the first new row in
+    // dst.
+    std::size_t
+        move_rows(const std::size_t* indices, std::size_t count, archetype& dst)
+    {
+        assert(&dst != this);
+
+        std::size_t src_col = 0;
+
+        for (auto& dst_col : dst.columns_)
+        {
+            const auto hash = dst_col->component_hash();
+
+            while (src_col != column_count() && hashes_[src_col] < hash)
+            {
+                ++src_col;
+            }
+
+            if (src_col != column_count() && hashes_[src_col] == hash)
+            {
+                columns_[src_col]->copy_rows_to(*dst_col, indices, count);
+            }
+            else
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    dst_col->push_back_default();
+                }
+            }
+        }
+
+        const auto first = dst.size();
+        detail::append_rows(dst.entities_, entities_, indices, count);
+        dst.fit_versions();
+
+        swap_pop_sorted(indices, count);
+        return first;
+    }
+
+    // copy row idx into dst and remove it from this archetype. Columns which
+    // only exist in dst receive a value initialized element, columns which
+    // only exist in this archetype are dropped. Returns the row in dst.
+    std::size_t move_row(std::size_t idx, archetype& dst)
+    {
+        assert(idx < size());
+        assert(&dst != this);
+
+        // both column lists are sorted, so merge through them.
+        std::size_t src_col = 0;
+
+        for (auto& dst_col : dst.columns_)
+        {
+            const auto hash = dst_col->component_hash();
+
+            while (src_col != column_count() && hashes_[src_col] < hash)
+            {
+                ++src_col;
+            }
+
+            if (src_col != column_count() && hashes_[src_col] == hash)
+            {
+                dst_col->push_back_from(*columns_[src_col], idx);
+            }
+            else
+            {
+                dst_col->push_back_default();
+            }
+        }
+
+        dst.entities_.push_back(entities_[idx]);
+        dst.fit_versions();
+
+        swap_pop(idx);
+        return dst.size() - 1;
+    }
+
+private:
+    // one version per chunk, new chunks start out unchanged.
+    void fit_versions()
+    {
+        const auto chunks = chunk_count();
+
+        if (!versions_.empty() && versions_.front().size() != chunks)
+        {
+            for (auto& col : versions_)
+            {
+                col.resize(chunks);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<polymorphic_container>>
+        replicate_columns() const
+    {
+        auto cols = std::vector<std::unique_ptr<polymorphic_container>>{};
+        cols.reserve(columns_.size() + 1);
+
+        for (const auto& col : columns_)
+        {
+            cols.push_back(col->replicate());
+        }
+
+        return cols;
+    }
+
+    template<typename T>
+    void push_column_value(T&& value)
+    {
+        using component_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+        auto* col = find(aecs::component_type<component_t>::hash());
+        assert(col && "component is not part of this archetype");
+        col->template push_back<component_t>(std::forward<T>(value));
+    }
+};
+} // namespace aecs
\ No newline at end of file
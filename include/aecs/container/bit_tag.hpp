@@ -0,0 +1,334 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aecs/component/concepts.hpp"
+
+namespace aecs
+{
+// A tag container which can be toggled per row. Every element is a single
+// bit telling whether the tag is enabled for that row, so flipping a tag
+// doesn't require moving the entity to another archetype.
+//
+// Select it through the container_type or make_container customization:
+//
+//   struct is_active
+//   {
+//       using container_type = aecs::bit_tag_container<is_active>;
+//   };
+//
+// Appending a T enables the tag, bits past size() are always zero. Enabled
+// rows are found 64 at a time with count trailing zeros.
+template<typename T>
+class bit_tag_container
+{
+    static_assert(std::is_same_v<T, std::remove_cv_t<T>>,
+                  "type cannot be const/volatile qualified");
+    static_assert(
+        aecs::is_tag_component_v<T>,
+        "Tag components must be empty and trivially default constructible");
+
+public:
+    class reference;
+
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using const_reference = bool;
+
+    static constexpr size_type bits_per_word = 64;
+
+private:
+    std::vector<std::uint64_t> words_;
+    size_type                  size_{};
+
+public:
+    bit_tag_container() = default;
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    // the packed bits, row i is bit i % 64 of word i / 64.
+    const std::uint64_t* words() const noexcept
+    {
+        return words_.data();
+    }
+
+    size_type word_count() const noexcept
+    {
+        return words_.size();
+    }
+
+    void reserve(size_type n)
+    {
+        words_.reserve((n + bits_per_word - 1) / bits_per_word);
+    }
+
+    bool test(size_type idx) const noexcept
+    {
+        assert(idx < size());
+        return (words_[idx / bits_per_word] >> (idx % bits_per_word)) & 1;
+    }
+
+    void set(size_type idx, bool enabled = true) noexcept
+    {
+        assert(idx < size());
+        const auto bit = std::uint64_t{1} << (idx % bits_per_word);
+
+        if (enabled)
+        {
+            words_[idx / bits_per_word] |= bit;
+        }
+        else
+        {
+            words_[idx / bits_per_word] &= ~bit;
+        }
+    }
+
+    void reset(size_type idx) noexcept
+    {
+        set(idx, false);
+    }
+
+    void flip(size_type idx) noexcept
+    {
+        assert(idx < size());
+        words_[idx / bits_per_word] ^= std::uint64_t{1}
+                                       << (idx % bits_per_word);
+    }
+
+    // amount of enabled rows
+    size_type count() const noexcept
+    {
+        size_type res = 0;
+
+        for (auto w : words_)
+        {
+            res += static_cast<size_type>(__builtin_popcountll(w));
+        }
+
+        return res;
+    }
+
+    // amount of enabled rows in [first, last)
+    size_type count(size_type first, size_type last) const noexcept
+    {
+        size_type res = 0;
+        for_each_word(first, last, [&](size_type, std::uint64_t bits) {
+            res += static_cast<size_type>(__builtin_popcountll(bits));
+        });
+        return res;
+    }
+
+    // call fn(row) for every enabled row in [first, last), ascending.
+    template<typename F>
+    void for_each_set(size_type first, size_type last, F&& fn) const
+    {
+        for_each_word(first, last, [&](size_type base, std::uint64_t bits) {
+            while (bits != 0)
+            {
+                fn(base + static_cast<size_type>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        });
+    }
+
+    template<typename F>
+    void for_each_set(F&& fn) const
+    {
+        for_each_set(0, size_, fn);
+    }
+
+    reference operator[](size_type idx) noexcept
+    {
+        assert(idx < size());
+        return reference{*this, idx};
+    }
+
+    bool operator[](size_type idx) const noexcept
+    {
+        return test(idx);
+    }
+
+    reference back() noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+    bool back() const noexcept
+    {
+        return test(size_ - 1);
+    }
+
+    void push_back(bool enabled)
+    {
+        if (size_ % bits_per_word == 0)
+        {
+            words_.push_back(0);
+        }
+
+        ++size_;
+        set(size_ - 1, enabled);
+    }
+
+    // append count bits packed like words(), row i of the input is bit i % 64
+    // of bits[i / 64]. Copies whole words when size() is a multiple of 64.
+    void append_bits(const std::uint64_t* bits, size_type count)
+    {
+        const auto offset = size_ % bits_per_word;
+        auto       dst    = size_ / bits_per_word;
+        const auto words  = (count + bits_per_word - 1) / bits_per_word;
+
+        words_.resize((size_ + count + bits_per_word - 1) / bits_per_word);
+
+        for (size_type w = 0; w != words; ++w, ++dst)
+        {
+            auto word = bits[w];
+
+            if (w == words - 1 && count % bits_per_word != 0)
+            {
+                word &= ~(~std::uint64_t{0} << (count % bits_per_word));
+            }
+
+            // bits past size() are zero, so or-ing is enough
+            words_[dst] |= word << offset;
+
+            if (offset != 0 && dst + 1 != words_.size())
+            {
+                words_[dst + 1] |= word >> (bits_per_word - offset);
+            }
+        }
+
+        size_ += count;
+    }
+
+    // a T is always an enabled tag
+    void push_back(const T&)
+    {
+        push_back(true);
+    }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        // T is trivial, only construct it for potential side effects
+        [[maybe_unused]] auto t = T(std::forward<Args>(args)...);
+        push_back(true);
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty());
+        reset(size_ - 1);
+        --size_;
+
+        if (size_ % bits_per_word == 0)
+        {
+            words_.pop_back();
+        }
+    }
+
+    // remove idx by moving the last bit into its place.
+    void swap_pop(size_type idx) noexcept
+    {
+        assert(idx < size());
+        set(idx, test(size_ - 1));
+        pop_back();
+    }
+
+    void clear() noexcept
+    {
+        words_.clear();
+        size_ = 0;
+    }
+
+private:
+    // call fn(first row of word, bits) for every word overlapping
+    // [first, last), bits outside the range are masked off.
+    template<typename F>
+    void for_each_word(size_type first, size_type last, F&& fn) const
+    {
+        assert(first <= last && last <= size());
+
+        if (first == last)
+        {
+            return;
+        }
+
+        const auto first_word = first / bits_per_word;
+        const auto last_word  = (last - 1) / bits_per_word;
+
+        for (auto w = first_word; w <= last_word; ++w)
+        {
+            auto bits = words_[w];
+
+            if (w == first_word)
+            {
+                bits &= ~std::uint64_t{0} << (first % bits_per_word);
+            }
+
+            if (w == last_word && last % bits_per_word != 0)
+            {
+                bits &= ~(~std::uint64_t{0} << (last % bits_per_word));
+            }
+
+            fn(w * bits_per_word, bits);
+        }
+    }
+};
+
+// Proxy to a single bit of a bit_tag_container. Converts to bool, assigning a
+// bool or a T (enabled) writes through.
+template<typename T>
+class bit_tag_container<T>::reference
+{
+private:
+    bit_tag_container* cont_;
+    size_type          idx_;
+
+public:
+    constexpr reference(bit_tag_container& cont, size_type idx) noexcept
+        : cont_{&cont}, idx_{idx}
+    {}
+
+    reference(const reference&) = default;
+
+    // assigns the value, never rebinds.
+    reference& operator=(const reference& other) noexcept
+    {
+        return *this = static_cast<bool>(other);
+    }
+
+    reference& operator=(bool enabled) noexcept
+    {
+        cont_->set(idx_, enabled);
+        return *this;
+    }
+
+    reference& operator=(const T&) noexcept
+    {
+        return *this = true;
+    }
+
+    operator bool() const noexcept
+    {
+        return cont_->test(idx_);
+    }
+
+    void flip() noexcept
+    {
+        cont_->flip(idx_);
+    }
+};
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,466 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aecs/component/concepts.hpp"
+
+namespace aecs
+{
+namespace detail
+{
+constexpr std::size_t bit_floor(std::size_t n) noexcept
+{
+    std::size_t res = 1;
+
+    while (res <= n / 2)
+    {
+        res *= 2;
+    }
+
+    return res;
+}
+
+constexpr std::size_t log2(std::size_t n) noexcept
+{
+    std::size_t res = 0;
+
+    while (n > 1)
+    {
+        n /= 2;
+        ++res;
+    }
+
+    return res;
+}
+} // namespace detail
+
+// A container storing its elements in fixed size blocks of BlockBytes. Growing
+// the container allocates a new block and never moves existing elements, so
+// references stay valid until the element is removed.
+//
+// The amount of elements per block is rounded down to a power of 2, which
+// makes operator[] a shift and a mask instead of a division. Blocks are
+// allocated for exactly that many elements, see block_bytes, so rounding
+// costs no memory but may halve the block size for awkward element sizes.
+template<typename T, std::size_t BlockBytes = 16384>
+class chunked_container
+{
+    static_assert(std::is_same_v<T, std::remove_cv_t<T>>,
+                  "type cannot be const/volatile qualified");
+    static_assert(aecs::is_component_v<T>,
+                  "chunked_container only stores trivially copyable types");
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+
+    // at least one element per block, even for huge types
+    static constexpr size_type elements_per_block =
+        detail::bit_floor(std::max(BlockBytes / sizeof(T), std::size_t{1}));
+
+    // the bytes of elements in a block, more than BlockBytes / 2 unless a
+    // single element is larger.
+    static constexpr size_type block_bytes = sizeof(T) * elements_per_block;
+
+private:
+    static constexpr size_type block_shift = detail::log2(elements_per_block);
+    static constexpr size_type block_mask  = elements_per_block - 1;
+
+    // cache line aligned, so chunks iterated from different threads never
+    // share a line at block boundaries.
+    struct block
+    {
+        alignas(std::max(alignof(T), std::size_t{64})) unsigned char
+            data[block_bytes];
+    };
+
+    template<bool Const>
+    class basic_iterator;
+
+public:
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+private:
+    std::vector<std::unique_ptr<block>> blocks_;
+    size_type                           size_{};
+
+public:
+    chunked_container() = default;
+
+    chunked_container(const chunked_container& other) : size_{other.size_}
+    {
+        blocks_.reserve(other.blocks_.size());
+
+        for (const auto& b : other.blocks_)
+        {
+            blocks_.push_back(std::make_unique<block>(*b));
+        }
+    }
+
+    chunked_container(chunked_container&&) noexcept = default;
+
+    chunked_container& operator=(const chunked_container& other)
+    {
+        auto copy = other;
+        swap(copy);
+        return *this;
+    }
+
+    chunked_container& operator=(chunked_container&&) noexcept = default;
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return blocks_.size() * elements_per_block;
+    }
+
+    size_type block_count() const noexcept
+    {
+        return blocks_.size();
+    }
+
+    // pointer to the first element of block idx. Elements within a block are
+    // contiguous.
+    pointer block_data(size_type idx) noexcept
+    {
+        assert(idx < block_count());
+        return std::launder(reinterpret_cast<T*>(blocks_[idx]->data));
+    }
+
+    const_pointer block_data(size_type idx) const noexcept
+    {
+        assert(idx < block_count());
+        return std::launder(reinterpret_cast<const T*>(blocks_[idx]->data));
+    }
+
+    // the amount of elements in use in block idx.
+    size_type block_size(size_type idx) const noexcept
+    {
+        assert(idx < block_count());
+        const auto first = idx * elements_per_block;
+        return size_ <= first ? 0
+                              : std::min(size_ - first, elements_per_block);
+    }
+
+    void reserve(size_type n)
+    {
+        while (capacity() < n)
+        {
+            blocks_.push_back(std::make_unique<block>());
+        }
+    }
+
+    reference operator[](size_type idx) noexcept
+    {
+        assert(idx < size());
+        return block_data(idx >> block_shift)[idx & block_mask];
+    }
+
+    const_reference operator[](size_type idx) const noexcept
+    {
+        assert(idx < size());
+        return block_data(idx >> block_shift)[idx & block_mask];
+    }
+
+    reference front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    reference back() noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+    const_reference back() const noexcept
+    {
+        return (*this)[size_ - 1];
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        reserve(size_ + 1);
+
+        auto* slot = blocks_[size_ >> block_shift]->data +
+                     (size_ & block_mask) * sizeof(T);
+        auto* res =
+            ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *res;
+    }
+
+    void push_back(const T& t)
+    {
+        emplace_back(t);
+    }
+
+    void push_back(T&& t)
+    {
+        emplace_back(std::move(t));
+    }
+
+    // append count elements starting at first, one memcpy per block touched.
+    void append(const T* first, size_type count)
+    {
+        reserve(size_ + count);
+
+        while (count != 0)
+        {
+            const auto offset = size_ & block_mask;
+            const auto len    = std::min(count, elements_per_block - offset);
+            auto*      dst =
+                blocks_[size_ >> block_shift]->data + offset * sizeof(T);
+            std::memcpy(dst, first, len * sizeof(T));
+            size_ += len;
+            first += len;
+            count -= len;
+        }
+    }
+
+    // trivially destructible, so popping only shrinks the size. Blocks are
+    // kept around for reuse.
+    void pop_back() noexcept
+    {
+        assert(!empty());
+        --size_;
+    }
+
+    // remove idx by moving the last element into its place.
+    void swap_pop(size_type idx) noexcept
+    {
+        assert(idx < size());
+
+        if (idx != size_ - 1)
+        {
+            (*this)[idx] = back();
+        }
+
+        pop_back();
+    }
+
+    void clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    // release blocks which are not in use.
+    void shrink_to_fit()
+    {
+        const auto required = (size_ + elements_per_block - 1) >> block_shift;
+        blocks_.resize(required);
+        blocks_.shrink_to_fit();
+    }
+
+    void swap(chunked_container& other) noexcept
+    {
+        using std::swap;
+        swap(blocks_, other.blocks_);
+        swap(size_, other.size_);
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator{this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return iterator{this, size_};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator{this, size_};
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+};
+
+template<typename T, std::size_t BlockBytes>
+template<bool Const>
+class chunked_container<T, BlockBytes>::basic_iterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = std::conditional_t<Const, const T&, T&>;
+    using pointer           = std::conditional_t<Const, const T*, T*>;
+
+private:
+    using container_pointer = std::
+        conditional_t<Const, const chunked_container*, chunked_container*>;
+
+    container_pointer cont_{nullptr};
+    difference_type   index_{};
+
+    friend class chunked_container;
+
+    template<bool>
+    friend class basic_iterator;
+
+    constexpr basic_iterator(container_pointer cont, size_type idx) noexcept
+        : cont_{cont}, index_{static_cast<difference_type>(idx)}
+    {}
+
+public:
+    constexpr basic_iterator() noexcept = default;
+
+    // iterator -> const_iterator
+    template<bool C = Const, typename = std::enable_if_t<C>>
+    constexpr basic_iterator(const basic_iterator<false>& other) noexcept
+        : cont_{other.cont_}, index_{other.index_}
+    {}
+
+    constexpr bool operator==(basic_iterator other) const noexcept
+    {
+        return index_ == other.index_;
+    }
+
+    constexpr bool operator!=(basic_iterator other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    constexpr bool operator<(basic_iterator other) const noexcept
+    {
+        return index_ < other.index_;
+    }
+
+    constexpr bool operator>(basic_iterator other) const noexcept
+    {
+        return index_ > other.index_;
+    }
+
+    constexpr bool operator<=(basic_iterator other) const noexcept
+    {
+        return index_ <= other.index_;
+    }
+
+    constexpr bool operator>=(basic_iterator other) const noexcept
+    {
+        return index_ >= other.index_;
+    }
+
+    constexpr basic_iterator& operator++() noexcept
+    {
+        ++index_;
+        return *this;
+    }
+
+    constexpr basic_iterator& operator--() noexcept
+    {
+        --index_;
+        return *this;
+    }
+
+    constexpr basic_iterator operator++(int) noexcept
+    {
+        auto res = *this;
+        ++(*this);
+        return res;
+    }
+
+    constexpr basic_iterator operator--(int) noexcept
+    {
+        auto res = *this;
+        --(*this);
+        return res;
+    }
+
+    constexpr basic_iterator& operator+=(difference_type diff) noexcept
+    {
+        index_ += diff;
+        return *this;
+    }
+
+    constexpr basic_iterator& operator-=(difference_type diff) noexcept
+    {
+        index_ -= diff;
+        return *this;
+    }
+
+    constexpr difference_type operator-(basic_iterator other) const noexcept
+    {
+        return index_ - other.index_;
+    }
+
+    constexpr basic_iterator operator-(difference_type diff) const noexcept
+    {
+        auto res = *this;
+        res -= diff;
+        return res;
+    }
+
+    constexpr basic_iterator operator+(difference_type diff) const noexcept
+    {
+        auto res = *this;
+        res += diff;
+        return res;
+    }
+
+    friend constexpr basic_iterator operator+(difference_type diff,
+                                              basic_iterator  it) noexcept
+    {
+        return it + diff;
+    }
+
+    reference operator*() const noexcept
+    {
+        return (*cont_)[static_cast<size_type>(index_)];
+    }
+
+    pointer operator->() const noexcept
+    {
+        return std::addressof(**this);
+    }
+
+    reference operator[](difference_type diff) const noexcept
+    {
+        return *(*this + diff);
+    }
+};
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/utility/name_hash.hpp"
+
+namespace aecs
+{
+// Describes a component type which is only known at runtime, such as
+// components defined by scripts or plugins. The component is a trivially
+// copyable blob of size bytes, a size of 0 makes it a tag.
+//
+// The hash is computed from the name the same way as component_type<T>::hash,
+// so a descriptor named like a C++ component has the same hash. A world only
+// stores one of them and rejects the other, as well as descriptors sharing a
+// name but not the size or alignment.
+class component_descriptor
+{
+private:
+    std::string name_;
+    std::size_t hash_;
+    std::size_t size_;
+    std::size_t alignment_;
+
+public:
+    component_descriptor(std::string name,
+                         std::size_t size,
+                         std::size_t alignment)
+        : name_{std::move(name)},
+          hash_{aecs::name_hash(name_)},
+          size_{size},
+          alignment_{alignment}
+    {
+        assert(alignment != 0 && (alignment & (alignment - 1)) == 0 &&
+               "alignment must be a power of 2");
+        assert(size % alignment == 0 && "size must be a multiple of alignment");
+    }
+
+    std::string_view name() const noexcept
+    {
+        return name_;
+    }
+
+    std::size_t hash() const noexcept
+    {
+        return hash_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    std::size_t alignment() const noexcept
+    {
+        return alignment_;
+    }
+};
+
+// A column of a runtime component type. Rows are stored as contiguous raw
+// bytes, aligned to the alignment of the descriptor, so dynamic components
+// get the same memcpy based bulk operations as native ones.
+//
+// Every replica shares the descriptor. Operations taking another container
+// expect it to be a dynamic_container of the same descriptor.
+class dynamic_container final : public polymorphic_container
+{
+private:
+    std::shared_ptr<const component_descriptor> desc_;
+    unsigned char*                              data_{nullptr};
+    std::size_t                                 size_{};
+    std::size_t                                 capacity_{};
+
+public:
+    explicit dynamic_container(
+        std::shared_ptr<const component_descriptor> desc) noexcept
+        : desc_{std::move(desc)}
+    {
+        assert(desc_);
+    }
+
+    dynamic_container(const dynamic_container&) = delete;
+    dynamic_container& operator=(const dynamic_container&) = delete;
+
+    ~dynamic_container() override
+    {
+        deallocate(data_);
+    }
+
+    const std::shared_ptr<const component_descriptor>&
+        descriptor() const noexcept
+    {
+        return desc_;
+    }
+
+    // the bytes of element 0, null for tags and empty containers.
+    void* data() noexcept
+    {
+        return data_;
+    }
+
+    const void* data() const noexcept
+    {
+        return data_;
+    }
+
+    void* element(std::size_t idx) noexcept
+    {
+        assert(idx < size_);
+        return data_ + idx * desc_->size();
+    }
+
+    const void* element(std::size_t idx) const noexcept
+    {
+        assert(idx < size_);
+        return data_ + idx * desc_->size();
+    }
+
+    void reserve(std::size_t n)
+    {
+        const auto bytes = desc_->size();
+
+        if (n <= capacity_ || bytes == 0)
+        {
+            capacity_ = std::max(capacity_, n);
+            return;
+        }
+
+        auto* new_data = static_cast<unsigned char*>(::operator new(
+            n * bytes, std::align_val_t{desc_->alignment()}));
+
+        if (size_ != 0)
+        {
+            std::memcpy(new_data, data_, size_ * bytes);
+        }
+
+        deallocate(data_);
+        data_     = new_data;
+        capacity_ = n;
+    }
+
+    std::size_t size() const override
+    {
+        return size_;
+    }
+
+    reference_hash operator[](std::size_t idx) override
+    {
+        return reference_hash{element(idx), desc_->hash()};
+    }
+
+private:
+    void do_push_back(const void* ptr) override
+    {
+        append(ptr, 1);
+    }
+
+    // other as a dynamic_container with elements laid out like this one.
+    const dynamic_container& same(const polymorphic_container& other) const
+    {
+        assert(dynamic_cast<const dynamic_container*>(&other) &&
+               other.component_hash() == component_hash() &&
+               other.element_size() == desc_->size() &&
+               other.element_alignment() == desc_->alignment() &&
+               "This is the wrong component type");
+        return static_cast<const dynamic_container&>(other);
+    }
+
+    void deallocate(unsigned char* ptr) const noexcept
+    {
+        if (ptr)
+        {
+            ::operator delete(ptr, std::align_val_t{desc_->alignment()});
+        }
+    }
+
+    void grow_for(std::size_t n)
+    {
+        if (n > capacity_)
+        {
+            reserve(std::max(n, capacity_ * 2));
+        }
+    }
+
+public:
+    std::unique_ptr<polymorphic_container> replicate() const override
+    {
+        return std::make_unique<dynamic_container>(desc_);
+    }
+
+    void swap_pop(std::size_t idx) override
+    {
+        assert(idx < size_);
+
+        if (idx != size_ - 1 && desc_->size() != 0)
+        {
+            std::memcpy(element(idx), element(size_ - 1), desc_->size());
+        }
+
+        --size_;
+    }
+
+    void push_back_from(const polymorphic_container& other,
+                        std::size_t                  idx) override
+    {
+        append(same(other).element(idx), 1);
+    }
+
+    void assign_from(std::size_t                  idx,
+                     const polymorphic_container& other,
+                     std::size_t                  other_idx) override
+    {
+        const auto& src = same(other);
+
+        if (desc_->size() != 0)
+        {
+            std::memcpy(element(idx), src.element(other_idx), desc_->size());
+        }
+    }
+
+    void append(const void* first, std::size_t count) override
+    {
+        grow_for(size_ + count);
+
+        if (desc_->size() != 0 && count != 0)
+        {
+            std::memcpy(data_ + size_ * desc_->size(),
+                        first,
+                        count * desc_->size());
+        }
+
+        size_ += count;
+    }
+
+    std::size_t raw_size(std::size_t count) const override
+    {
+        return count * desc_->size();
+    }
+
+    void copy_raw(void* dst) const override
+    {
+        if (size_ != 0 && desc_->size() != 0)
+        {
+            std::memcpy(dst, data_, size_ * desc_->size());
+        }
+    }
+
+    void append_raw(const void* src, std::size_t count) override
+    {
+        append(src, count);
+    }
+
+    std::size_t element_size() const override
+    {
+        return desc_->size();
+    }
+
+    std::size_t element_alignment() const override
+    {
+        return desc_->alignment();
+    }
+
+    std::size_t run_count() const override
+    {
+        return size_ != 0 && desc_->size() != 0 ? 1 : 0;
+    }
+
+    raw_run run([[maybe_unused]] std::size_t r) override
+    {
+        assert(r < run_count());
+        return raw_run{data_, size_};
+    }
+
+    const_raw_run run([[maybe_unused]] std::size_t r) const override
+    {
+        assert(r < run_count());
+        return const_raw_run{data_, size_};
+    }
+
+    void copy_rows_to(polymorphic_container& dst,
+                      const std::size_t*     indices,
+                      std::size_t            count) const override
+    {
+        same(dst);
+        auto& real_dst = static_cast<dynamic_container&>(dst);
+        real_dst.grow_for(real_dst.size_ + count);
+
+        std::size_t i = 0;
+
+        // consecutive indices are copied as a single run
+        while (i != count)
+        {
+            auto run = std::size_t{1};
+
+            while (i + run != count && indices[i + run] == indices[i] + run)
+            {
+                ++run;
+            }
+
+            real_dst.append(data_ + indices[i] * desc_->size(), run);
+            i += run;
+        }
+    }
+
+    void swap_pop_sorted(const std::size_t* indices,
+                         std::size_t        count) override
+    {
+        for (auto i = count; i != 0; --i)
+        {
+            swap_pop(indices[i - 1]);
+        }
+    }
+
+    void permute(const std::size_t* order) override
+    {
+        auto res = dynamic_container{desc_};
+        copy_rows_to(res, order, size_);
+        std::swap(data_, res.data_);
+        std::swap(capacity_, res.capacity_);
+    }
+
+    void push_back_default() override
+    {
+        grow_for(size_ + 1);
+        ++size_;
+
+        if (desc_->size() != 0)
+        {
+            std::memset(element(size_ - 1), 0, desc_->size());
+        }
+    }
+
+    std::size_t component_hash() const override
+    {
+        return desc_->hash();
+    }
+
+    std::string_view component_name() const override
+    {
+        return desc_->name();
+    }
+};
+} // namespace aecs
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cassert>
 #include <memory>
+#include <string_view>
 
 #include "aecs/component/traits.hpp"
 #include "aecs/component/type.hpp"
@@ -22,6 +24,11 @@ public:
         : ptr_{std::addressof(ref)}, hash_{aecs::component_type<T>::hash()}
     {}
 
+    // type erased construction, ptr must point to a component with hash.
+    constexpr reference_hash(void* ptr, std::size_t hash) noexcept
+        : ptr_{ptr}, hash_{hash}
+    {}
+
     template<typename T>
     constexpr T& get() const noexcept
     {
@@ -30,12 +37,31 @@ public:
         return *static_cast<T*>(ptr_);
     }
 
+    // the address of the value, for components without a C++ type.
+    constexpr void* ptr() const noexcept
+    {
+        return ptr_;
+    }
+
     constexpr std::size_t hash() const noexcept
     {
         return hash_;
     }
 };
 
+// a contiguous run of elements, see polymorphic_container::run.
+struct raw_run
+{
+    void*       data;
+    std::size_t size;
+};
+
+struct const_raw_run
+{
+    const void* data;
+    std::size_t size;
+};
+
 class polymorphic_container
 {
 public:
@@ -54,6 +80,102 @@ public:
 
     virtual void swap_pop(std::size_t index) = 0;
 
+    // append a copy of element idx of other, which must hold the same
+    // component type.
+    virtual void push_back_from(const polymorphic_container& other,
+                                std::size_t                  idx) = 0;
+
+    // overwrite element idx with a copy of element other_idx of other, which
+    // must hold the same component type.
+    virtual void assign_from(std::size_t                  idx,
+                             const polymorphic_container& other,
+                             std::size_t                  other_idx) = 0;
+
+    // append count elements from the raw buffer first, which must point to
+    // count contiguous objects of the component type.
+    virtual void append(const void* first, std::size_t count) = 0;
+
+    // bytes needed by copy_raw for count elements.
+    virtual std::size_t raw_size(std::size_t count) const = 0;
+
+    // write every element to dst as plain bytes, dst must have room for
+    // raw_size(size()) bytes and be aligned for the component type.
+    virtual void copy_raw(void* dst) const = 0;
+
+    // append count elements from bytes written by copy_raw.
+    virtual void append_raw(const void* src, std::size_t count) = 0;
+
+    // append copies of the elements at the count indices to dst, which must
+    // hold the same component type. Consecutive indices are copied as a run.
+    virtual void copy_rows_to(polymorphic_container& dst,
+                              const std::size_t*     indices,
+                              std::size_t            count) const = 0;
+
+    // remove the elements at the count ascending indices. Equivalent to
+    // calling swap_pop on each index from the highest to the lowest.
+    virtual void swap_pop_sorted(const std::size_t* indices,
+                                 std::size_t        count) = 0;
+
+    // reorder the elements, element i becomes the element previously at
+    // order[i]. order must be a permutation of [0, size()).
+    virtual void permute(const std::size_t* order) = 0;
+
+    // copy_rows_to followed by swap_pop_sorted, indices must be ascending.
+    void move_rows_to(polymorphic_container& dst,
+                      const std::size_t*     indices,
+                      std::size_t            count)
+    {
+        copy_rows_to(dst, indices, count);
+        swap_pop_sorted(indices, count);
+    }
+
+    // Type erased access to the storage, so whole columns can be processed
+    // with memcpy or SIMD instead of one virtual call per element. Elements
+    // are element_size() bytes apart, aligned to element_alignment() and
+    // split in run_count() contiguous runs in order. Containers without
+    // addressable elements, such as tags, bit packed tags and soa_container,
+    // have an element_size() of 0 and no runs.
+    virtual std::size_t element_size() const = 0;
+
+    virtual std::size_t element_alignment() const = 0;
+
+    virtual std::size_t run_count() const = 0;
+
+    virtual raw_run run(std::size_t r) = 0;
+
+    virtual const_raw_run run(std::size_t r) const = 0;
+
+    // call fn(index of the first element, data, size) for every run.
+    template<typename F>
+    void for_each_run(F&& fn)
+    {
+        std::size_t first = 0;
+
+        for (std::size_t r = 0; r != run_count(); ++r)
+        {
+            const auto rr = run(r);
+            fn(first, rr.data, rr.size);
+            first += rr.size;
+        }
+    }
+
+    template<typename F>
+    void for_each_run(F&& fn) const
+    {
+        std::size_t first = 0;
+
+        for (std::size_t r = 0; r != run_count(); ++r)
+        {
+            const auto rr = run(r);
+            fn(first, rr.data, rr.size);
+            first += rr.size;
+        }
+    }
+
+    // append a value initialized element. Used to fill columns which have no
+    // source value when moving rows between archetypes.
+    virtual void push_back_default() = 0;
+
     virtual std::size_t component_hash() const = 0;
 
     virtual std::string_view component_name() const = 0;
@@ -64,6 +186,14 @@ public:
         return aecs::component_type<T>::hash() == component_hash();
     }
 
+    // true if this is a wrapped_container<T>. A column with the hash of T can
+    // be a different container, such as a dynamic_container named like T.
+    template<typename T>
+    bool is_wrapped() const noexcept
+    {
+        return dynamic_cast<const wrapped_container<T>*>(this) != nullptr;
+    }
+
     template<typename T, typename... Args>
     void push_back(Args&&... args)
     {
@@ -75,14 +205,14 @@ public:
     template<typename T>
     aecs::component_container_t<T>& get() noexcept
     {
-        assert(has_component<T>() && "This is the wrong component type");
+        assert(is_wrapped<T>() && "This is the wrong component type");
         return static_cast<wrapped_container<T>&>(*this).get();
     }
 
     template<typename T>
     const aecs::component_container_t<T>& get() const noexcept
     {
-        assert(has_component<T>() && "This is the wrong component type");
+        assert(is_wrapped<T>() && "This is the wrong component type");
         return static_cast<const wrapped_container<T>&>(*this).get();
     }
 };
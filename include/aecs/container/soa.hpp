@@ -0,0 +1,401 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aecs/component/concepts.hpp"
+#include "aecs/utility/aggregate.hpp"
+
+namespace aecs
+{
+template<typename T, bool Const>
+class soa_reference;
+
+// A bool member of a soa_container. std::vector<bool> packs its elements in
+// bits and has no bool& to hand out, so bool members are stored as these.
+struct soa_bool
+{
+    bool value;
+};
+
+namespace detail
+{
+namespace soa
+{
+template<typename M>
+struct storage
+{
+    using type = M;
+};
+
+template<>
+struct storage<bool>
+{
+    using type = aecs::soa_bool;
+};
+
+template<typename M>
+constexpr M& element(M& m) noexcept
+{
+    return m;
+}
+
+constexpr bool& element(aecs::soa_bool& m) noexcept
+{
+    return m.value;
+}
+
+constexpr const bool& element(const aecs::soa_bool& m) noexcept
+{
+    return m.value;
+}
+} // namespace soa
+} // namespace detail
+
+// A structure of arrays container. Every member of the aggregate T is stored
+// in its own vector, so a loop which touches only some members only pulls
+// those through the cache and can be vectorized over the member arrays.
+//
+// Elements are accessed through soa_reference proxies, the member arrays are
+// accessed directly through member<I>(). bool members are stored as soa_bool.
+template<typename T>
+class soa_container
+{
+    static_assert(std::is_same_v<T, std::remove_cv_t<T>>,
+                  "type cannot be const/volatile qualified");
+    static_assert(aecs::is_component_v<T>,
+                  "soa_container only stores trivially copyable types");
+    static_assert(std::is_aggregate_v<T>,
+                  "soa_container can only split aggregates");
+
+public:
+    static constexpr std::size_t member_count = aecs::aggregate_arity_v<T>;
+
+    template<std::size_t I>
+    using member_type = aecs::aggregate_member_t<I, T>;
+
+    // the element type of the array of member I
+    template<std::size_t I>
+    using member_storage_type =
+        typename detail::soa::storage<member_type<I>>::type;
+
+private:
+    template<std::size_t... Is>
+    static auto make_storage(std::index_sequence<Is...>)
+        -> std::tuple<std::vector<member_storage_type<Is>>...>;
+
+    using indices      = std::make_index_sequence<member_count>;
+    using storage_type = decltype(make_storage(indices{}));
+
+    template<bool Const>
+    class basic_iterator;
+
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = soa_reference<T, false>;
+    using const_reference = soa_reference<T, true>;
+    using iterator        = basic_iterator<false>;
+    using const_iterator  = basic_iterator<true>;
+
+private:
+    storage_type members_;
+
+public:
+    soa_container() = default;
+
+    // the array storing member I of every element
+    template<std::size_t I>
+    std::vector<member_storage_type<I>>& member() noexcept
+    {
+        return std::get<I>(members_);
+    }
+
+    template<std::size_t I>
+    const std::vector<member_storage_type<I>>& member() const noexcept
+    {
+        return std::get<I>(members_);
+    }
+
+    size_type size() const noexcept
+    {
+        return std::get<0>(members_).size();
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    void reserve(size_type n)
+    {
+        std::apply([n](auto&... vecs) { (vecs.reserve(n), ...); }, members_);
+    }
+
+    reference operator[](size_type idx) noexcept
+    {
+        assert(idx < size());
+        return std::apply(
+            [idx](auto&... vecs) {
+                return reference{detail::soa::element(vecs[idx])...};
+            },
+            members_);
+    }
+
+    const_reference operator[](size_type idx) const noexcept
+    {
+        assert(idx < size());
+        return std::apply(
+            [idx](const auto&... vecs) {
+                return const_reference{detail::soa::element(vecs[idx])...};
+            },
+            members_);
+    }
+
+    reference front() noexcept
+    {
+        return (*this)[0];
+    }
+
+    const_reference front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    reference back() noexcept
+    {
+        return (*this)[size() - 1];
+    }
+
+    const_reference back() const noexcept
+    {
+        return (*this)[size() - 1];
+    }
+
+    void push_back(const T& t)
+    {
+        push_back_impl(t, indices{});
+    }
+
+    template<typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        push_back(T(std::forward<Args>(args)...));
+        return back();
+    }
+
+    void pop_back() noexcept
+    {
+        assert(!empty());
+        std::apply([](auto&... vecs) { (vecs.pop_back(), ...); }, members_);
+    }
+
+    // remove idx by moving the last element into its place, per member.
+    void swap_pop(size_type idx) noexcept
+    {
+        assert(idx < size());
+        std::apply(
+            [idx](auto&... vecs) {
+                ((vecs[idx] = vecs.back(), vecs.pop_back()), ...);
+            },
+            members_);
+    }
+
+    void clear() noexcept
+    {
+        std::apply([](auto&... vecs) { (vecs.clear(), ...); }, members_);
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator{this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return iterator{this, size()};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator{this, size()};
+    }
+
+private:
+    template<std::size_t... Is>
+    void push_back_impl(const T& t, std::index_sequence<Is...>)
+    {
+        auto members = aecs::tie_members(t);
+        (std::get<Is>(members_).push_back({std::get<Is>(members)}), ...);
+    }
+};
+
+// Proxy to an element of a soa_container. Converts to T, assigning a T or
+// another proxy writes through to the member arrays.
+template<typename T, bool Const>
+class soa_reference
+{
+private:
+    template<std::size_t... Is>
+    static auto make_refs(std::index_sequence<Is...>) -> std::tuple<
+        std::conditional_t<Const,
+                           const aecs::aggregate_member_t<Is, T>&,
+                           aecs::aggregate_member_t<Is, T>&>...>;
+
+    using indices   = std::make_index_sequence<aecs::aggregate_arity_v<T>>;
+    using refs_type = decltype(make_refs(indices{}));
+
+    refs_type refs_;
+
+public:
+    template<typename... Ms>
+    constexpr explicit soa_reference(Ms&... members) noexcept
+        : refs_{members...}
+    {}
+
+    // copy assignment assigns through the tuple of references, so like all
+    // other assignments it writes the value and never rebinds.
+    soa_reference(const soa_reference&) = default;
+    soa_reference& operator=(const soa_reference&) = default;
+
+    // reference to member I
+    template<std::size_t I>
+    constexpr decltype(auto) get() const noexcept
+    {
+        return std::get<I>(refs_);
+    }
+
+    constexpr operator T() const noexcept
+    {
+        return std::apply([](const auto&... ms) { return T{ms...}; }, refs_);
+    }
+
+    template<bool C = Const, typename = std::enable_if_t<!C>>
+    const soa_reference& operator=(const T& t) const noexcept
+    {
+        assign(aecs::tie_members(t), indices{});
+        return *this;
+    }
+
+private:
+    template<typename Tuple, std::size_t... Is>
+    void assign(const Tuple& values, std::index_sequence<Is...>) const noexcept
+    {
+        ((std::get<Is>(refs_) = std::get<Is>(values)), ...);
+    }
+};
+
+template<typename T>
+template<bool Const>
+class soa_container<T>::basic_iterator
+{
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using reference         = soa_reference<T, Const>;
+    using pointer           = void;
+
+private:
+    using container_pointer =
+        std::conditional_t<Const, const soa_container*, soa_container*>;
+
+    container_pointer cont_{nullptr};
+    difference_type   index_{};
+
+public:
+    constexpr basic_iterator() noexcept = default;
+
+    constexpr basic_iterator(container_pointer cont, size_type idx) noexcept
+        : cont_{cont}, index_{static_cast<difference_type>(idx)}
+    {}
+
+    constexpr bool operator==(basic_iterator other) const noexcept
+    {
+        return index_ == other.index_;
+    }
+
+    constexpr bool operator!=(basic_iterator other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    constexpr bool operator<(basic_iterator other) const noexcept
+    {
+        return index_ < other.index_;
+    }
+
+    constexpr basic_iterator& operator++() noexcept
+    {
+        ++index_;
+        return *this;
+    }
+
+    constexpr basic_iterator& operator--() noexcept
+    {
+        --index_;
+        return *this;
+    }
+
+    constexpr basic_iterator operator++(int) noexcept
+    {
+        auto res = *this;
+        ++(*this);
+        return res;
+    }
+
+    constexpr basic_iterator operator--(int) noexcept
+    {
+        auto res = *this;
+        --(*this);
+        return res;
+    }
+
+    constexpr basic_iterator& operator+=(difference_type diff) noexcept
+    {
+        index_ += diff;
+        return *this;
+    }
+
+    constexpr basic_iterator& operator-=(difference_type diff) noexcept
+    {
+        index_ -= diff;
+        return *this;
+    }
+
+    constexpr difference_type operator-(basic_iterator other) const noexcept
+    {
+        return index_ - other.index_;
+    }
+
+    constexpr basic_iterator operator+(difference_type diff) const noexcept
+    {
+        auto res = *this;
+        res += diff;
+        return res;
+    }
+
+    constexpr basic_iterator operator-(difference_type diff) const noexcept
+    {
+        auto res = *this;
+        res -= diff;
+        return res;
+    }
+
+    reference operator*() const noexcept
+    {
+        return (*cont_)[static_cast<size_type>(index_)];
+    }
+};
+} // namespace aecs
\ No newline at end of file
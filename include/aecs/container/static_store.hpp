@@ -0,0 +1,212 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aecs/component/set.hpp"
+#include "aecs/component/traits.hpp"
+#include "aecs/component/type.hpp"
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/wrapped.hpp"
+
+namespace aecs
+{
+// A table of the components Ts, which are all known at compile time. Every
+// row holds one value of each component.
+//
+// The columns are wrapped_containers stored by value in a tuple. As
+// wrapped_container is final, every operation on them is resolved at compile
+// time and inlined, no vtable is involved. column(idx) still hands out the
+// polymorphic_container interface of a column for tooling, which is just
+// the address of the tuple element.
+template<typename... Ts>
+class static_store
+{
+    static_assert(sizeof...(Ts) != 0, "a store needs at least one component");
+
+public:
+    using set = aecs::component_set<Ts...>;
+
+    template<typename T>
+    using container_type = aecs::component_container_t<T>;
+
+private:
+    std::tuple<aecs::wrapped_container<Ts>...> columns_;
+
+    // true if Us is a permutation of Ts
+    template<typename... Us>
+    static constexpr bool is_row_v =
+        sizeof...(Us) == sizeof...(Ts) &&
+        ((aecs::type_count_v<Ts, Us...> == 1) && ...);
+
+public:
+    static_store() = default;
+
+    static constexpr std::size_t column_count() noexcept
+    {
+        return sizeof...(Ts);
+    }
+
+    // the hash of column idx, columns are in the order of Ts.
+    static constexpr std::size_t component_hash(std::size_t idx) noexcept
+    {
+        constexpr std::array<std::size_t, sizeof...(Ts)> hashes{
+            aecs::component_type<Ts>::hash()...};
+        return hashes[idx];
+    }
+
+    // index of the column storing hash, or column_count() if not found.
+    static constexpr std::size_t column_index(std::size_t hash) noexcept
+    {
+        const auto idx = set::index(hash);
+        return idx == set::npos ? column_count() : idx;
+    }
+
+    template<typename T>
+    static constexpr bool has_component() noexcept
+    {
+        return (std::is_same_v<T, Ts> || ...);
+    }
+
+    // number of rows
+    std::size_t size() const noexcept
+    {
+        return std::get<0>(columns_).size();
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    template<typename T>
+    aecs::wrapped_container<T>& column() noexcept
+    {
+        static_assert(has_component<T>(), "T is not part of this store");
+        return std::get<aecs::wrapped_container<T>>(columns_);
+    }
+
+    template<typename T>
+    const aecs::wrapped_container<T>& column() const noexcept
+    {
+        static_assert(has_component<T>(), "T is not part of this store");
+        return std::get<aecs::wrapped_container<T>>(columns_);
+    }
+
+    // the polymorphic interface of column idx.
+    aecs::polymorphic_container& column(std::size_t idx) noexcept
+    {
+        assert(idx < column_count());
+        return *columns(std::index_sequence_for<Ts...>{})[idx];
+    }
+
+    const aecs::polymorphic_container& column(std::size_t idx) const noexcept
+    {
+        return const_cast<static_store&>(*this).column(idx);
+    }
+
+    template<typename T>
+    container_type<T>& get() noexcept
+    {
+        return column<T>().get();
+    }
+
+    template<typename T>
+    const container_type<T>& get() const noexcept
+    {
+        return column<T>().get();
+    }
+
+    // call fn with every wrapped_container, in the order of Ts.
+    template<typename F>
+    void for_each_column(F&& fn)
+    {
+        std::apply([&](auto&... cols) { (fn(cols), ...); }, columns_);
+    }
+
+    template<typename F>
+    void for_each_column(F&& fn) const
+    {
+        std::apply([&](const auto&... cols) { (fn(cols), ...); }, columns_);
+    }
+
+    // append a row, a value for every component has to be provided in any
+    // order. Returns the index of the new row.
+    template<typename... Us>
+    std::size_t push_back(Us&&... values)
+    {
+        static_assert(
+            is_row_v<std::remove_cv_t<std::remove_reference_t<Us>>...>,
+            "a value is required for every column, exactly once");
+        (get<std::remove_cv_t<std::remove_reference_t<Us>>>().push_back(
+             std::forward<Us>(values)),
+         ...);
+        return size() - 1;
+    }
+
+    // append count rows, first[i] points to count values of Ts[i].
+    void append(std::size_t count, const Ts*... first)
+    {
+        (column<Ts>().append(first, count), ...);
+    }
+
+    // remove row idx by moving the last row into its place, in every column.
+    void swap_pop(std::size_t idx)
+    {
+        assert(idx < size());
+        for_each_column([&](auto& col) { col.swap_pop(idx); });
+    }
+
+    // remove the rows at the count ascending indices from every column, see
+    // polymorphic_container::swap_pop_sorted.
+    void swap_pop_sorted(const std::size_t* indices, std::size_t count)
+    {
+        assert(count <= size());
+        for_each_column(
+            [&](auto& col) { col.swap_pop_sorted(indices, count); });
+    }
+
+    // append row idx to dst and remove it from this store. Returns the row in
+    // dst.
+    std::size_t move_row(std::size_t idx, static_store& dst)
+    {
+        assert(idx < size());
+        (dst.column<Ts>().push_back_from(column<Ts>(), idx), ...);
+        swap_pop(idx);
+        return dst.size() - 1;
+    }
+
+    // append the rows at the count indices to dst, in the order of indices.
+    // Returns the first new row in dst.
+    std::size_t copy_rows_to(static_store&      dst,
+                             const std::size_t* indices,
+                             std::size_t        count) const
+    {
+        const auto first = dst.size();
+        (column<Ts>().copy_rows_to(dst.column<Ts>(), indices, count), ...);
+        return first;
+    }
+
+    // copy_rows_to followed by swap_pop_sorted, indices must be ascending.
+    std::size_t move_rows_to(static_store&      dst,
+                             const std::size_t* indices,
+                             std::size_t        count)
+    {
+        const auto first = copy_rows_to(dst, indices, count);
+        swap_pop_sorted(indices, count);
+        return first;
+    }
+
+private:
+    template<std::size_t... Is>
+    std::array<aecs::polymorphic_container*, sizeof...(Ts)>
+        columns(std::index_sequence<Is...>) noexcept
+    {
+        return {&std::get<Is>(columns_)...};
+    }
+};
+} // namespace aecs
\ No newline at end of file
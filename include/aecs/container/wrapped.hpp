@@ -1,11 +1,33 @@
 #pragma once
 
+#include <cassert>
+#include <new>
+#include <type_traits>
+
 #include "aecs/component/traits.hpp"
 #include "aecs/component/type.hpp"
+#include "aecs/container/algorithm.hpp"
 #include "aecs/container/polymorphic.hpp"
 
 namespace aecs
 {
+namespace detail
+{
+template<typename C, typename = void>
+struct has_swap_pop : std::false_type
+{};
+
+template<typename C>
+struct has_swap_pop<
+    C,
+    std::void_t<decltype(std::declval<C&>().swap_pop(std::size_t{}))>>
+    : std::true_type
+{};
+
+template<typename C>
+inline constexpr bool has_swap_pop_v = has_swap_pop<C>::value;
+} // namespace detail
+
 template<typename T>
 class wrapped_container final : public polymorphic_container
 {
@@ -51,7 +73,17 @@ public:
 
     reference_hash operator[](std::size_t idx) override
     {
-        return reference_hash{container_[idx]};
+        if constexpr (std::is_lvalue_reference_v<decltype(container_[idx])>)
+        {
+            return reference_hash{container_[idx]};
+        }
+        else
+        {
+            // proxy containers such as soa_container have no T object to
+            // point to.
+            assert(false && "This container does not store addressable T");
+            return reference_hash{nullptr, component_hash()};
+        }
     }
 
     void do_push_back(const void* ptr) override
@@ -67,14 +99,131 @@ public:
 
     void swap_pop(std::size_t idx) override
     {
-        auto it = container_.begin() + idx;
+        if constexpr (detail::has_swap_pop_v<container_type>)
+        {
+            // containers such as chunked_container know how to do this best
+            container_.swap_pop(idx);
+        }
+        else
+        {
+            auto it = container_.begin() + idx;
+
+            // perform swap
+            using std::swap;
+            swap(*it, container_.back());
+
+            // and pop
+            container_.pop_back();
+        }
+    }
+
+    void push_back_from(const polymorphic_container& other,
+                        std::size_t                  idx) override
+    {
+        assert(other.is_wrapped<T>() && "This is the wrong component type");
+        const auto& src = static_cast<const wrapped_container<T>&>(other);
+        container_.push_back(src.container_[idx]);
+    }
+
+    void assign_from(std::size_t                  idx,
+                     const polymorphic_container& other,
+                     std::size_t                  other_idx) override
+    {
+        assert(other.is_wrapped<T>() && "This is the wrong component type");
+        const auto& src = static_cast<const wrapped_container<T>&>(other);
+
+        if constexpr (std::is_assignable_v<decltype(container_[idx]),
+                                           decltype(src.container_[idx])>)
+        {
+            container_[idx] = src.container_[other_idx];
+        }
+        else
+        {
+            // through T, so proxy references of soa_container work as well
+            container_[idx] = static_cast<T>(src.container_[other_idx]);
+        }
+    }
+
+    void append(const void* first, std::size_t count) override
+    {
+        detail::append_n(container_, static_cast<const T*>(first), count);
+    }
+
+    std::size_t raw_size(std::size_t count) const override
+    {
+        return detail::raw_size<T, container_type>(count);
+    }
+
+    void copy_raw(void* dst) const override
+    {
+        detail::copy_raw<T>(container_, dst);
+    }
 
-        // perform swap
-        using std::swap;
-        swap(*it, container_.back());
+    void append_raw(const void* src, std::size_t count) override
+    {
+        detail::append_raw<T>(container_, src, count);
+    }
 
-        // and pop
-        container_.pop_back();
+    std::size_t element_size() const override
+    {
+        return detail::has_runs_v<T, container_type> ? sizeof(T) : 0;
+    }
+
+    std::size_t element_alignment() const override
+    {
+        return alignof(T);
+    }
+
+    std::size_t run_count() const override
+    {
+        return detail::run_count<T>(container_);
+    }
+
+    raw_run run(std::size_t r) override
+    {
+        return make_run<raw_run>(container_, r);
+    }
+
+    const_raw_run run(std::size_t r) const override
+    {
+        return make_run<const_raw_run>(container_, r);
+    }
+
+    void copy_rows_to(polymorphic_container& dst,
+                      const std::size_t*     indices,
+                      std::size_t            count) const override
+    {
+        assert(dst.is_wrapped<T>() && "This is the wrong component type");
+        auto& real_dst = static_cast<wrapped_container<T>&>(dst);
+        detail::append_rows(real_dst.container_, container_, indices, count);
+    }
+
+    void swap_pop_sorted(const std::size_t* indices,
+                         std::size_t        count) override
+    {
+        detail::swap_pop_sorted(container_, indices, count);
+    }
+
+    void permute(const std::size_t* order) override
+    {
+        // ascending runs of order are copied as a whole
+        auto res = aecs::component_type<T>::make_container();
+        detail::append_rows(res, container_, order, container_.size());
+        container_ = std::move(res);
+    }
+
+    void push_back_default() override
+    {
+        if constexpr (std::is_default_constructible_v<T>)
+        {
+            container_.push_back(T{});
+        }
+        else
+        {
+            // trivially copyable, so all zero bytes are a valid stand-in.
+            std::aligned_storage_t<sizeof(T), alignof(T)> storage{};
+            container_.push_back(*std::launder(reinterpret_cast<T*>(&storage)));
+        }
     }
 
     std::size_t component_hash() const override
@@ -86,5 +235,22 @@ public:
     {
         return aecs::component_type<T>::name();
     }
+
+private:
+    // run r of c as Run, raw_run or const_raw_run.
+    template<typename Run, typename C>
+    static Run make_run(C& c, [[maybe_unused]] std::size_t r) noexcept
+    {
+        if constexpr (detail::has_runs_v<T, container_type>)
+        {
+            const auto res = detail::run<T>(c, r);
+            return Run{res.first, res.second};
+        }
+        else
+        {
+            assert(false && "This container has no contiguous runs");
+            return Run{nullptr, 0};
+        }
+    }
 };
 } // namespace aecs
\ No newline at end of file
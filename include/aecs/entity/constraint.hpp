@@ -133,6 +133,25 @@ public:
     }
 };
 
+namespace detail
+{
+// std::sort is not constexpr before C++20, constraint lists are tiny anyway.
+template<typename T, std::size_t N>
+constexpr void insertion_sort(std::array<T, N>& arr) noexcept
+{
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        for (auto j = i; j != 0 && arr[j] < arr[j - 1]; --j)
+        {
+            auto tmp   = arr[j];
+            arr[j]     = arr[j - 1];
+            arr[j - 1] = tmp;
+        }
+    }
+}
+} // namespace detail
+
+// sorted by constraint::operator<, this makes it usable at compile time.
 template<std::size_t N>
 class constraint_list
 {
@@ -146,7 +165,7 @@ public:
         : arr_{[&]() {
               auto mutable_arr = std::array<constraint, sizeof...(Ts)>{
                   constraint{std::forward<Ts>(constraints)}...};
-              std::sort(mutable_arr.begin(), mutable_arr.end());
+              detail::insertion_sort(mutable_arr);
               return mutable_arr;
           }()}
     {}
@@ -192,6 +211,12 @@ public:
         : first_{cs.data()}, last_{first_ + N}
     {}
 
+    // [first, last) must be sorted, like the contents of a constraint_list.
+    constexpr constraint_view(const constraint* first,
+                              const constraint* last) noexcept
+        : first_{first}, last_{last}
+    {}
+
     constexpr const auto* begin() const noexcept
     {
         return first_;
@@ -209,25 +234,30 @@ public:
 
     constexpr bool allow_parallelism(constraint_view other) const noexcept
     {
+        // if any exclude has the same hash as a component accessed by the
+        // other it makes the entire constraint parallel. Checked for all
+        // pairs first, as conflicts may be sorted before the exclude.
         for (const auto& c1 : *this)
         {
             for (const auto& c2 : other)
             {
-                if (c1.access() == access::exclude ||
-                    c2.access() == access::exclude)
+                if ((c1.access() == access::exclude ||
+                     c2.access() == access::exclude) &&
+                    c1.hash() == c2.hash() && c1.access() != c2.access())
                 {
-                    // if any exclude has the same hash it makes the entire
-                    // constraint parallel
-                    if (c1.hash() == c2.hash() && c1.access() != c2.access())
-                    {
-                        return true;
-                    }
+                    return true;
                 }
-                else if (!c1.allow_parallelism(c2))
+            }
+        }
+
+        for (const auto& c1 : *this)
+        {
+            for (const auto& c2 : other)
+            {
+                if (c1.access() != access::exclude &&
+                    c2.access() != access::exclude &&
+                    !c1.allow_parallelism(c2))
                 {
-                    // I can only do this here because the constraint are
-                    // guaranteed to be sorted with exclude constraints coming
-                    // first as they're the most impactful.
                     return false;
                 }
             }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+namespace aecs
+{
+namespace entity
+{
+// A generational entity handle. The index refers to a slot in the
+// entity::registry, the generation is incremented every time that slot is
+// released, which makes stale handles detectable.
+class id
+{
+public:
+    static constexpr std::uint32_t invalid_index =
+        std::numeric_limits<std::uint32_t>::max();
+
+private:
+    std::uint32_t index_{invalid_index};
+    std::uint32_t generation_{};
+
+public:
+    constexpr id() noexcept = default;
+
+    constexpr id(std::uint32_t index, std::uint32_t generation) noexcept
+        : index_{index}, generation_{generation}
+    {}
+
+    constexpr std::uint32_t index() const noexcept
+    {
+        return index_;
+    }
+
+    constexpr std::uint32_t generation() const noexcept
+    {
+        return generation_;
+    }
+
+    // the index and generation packed in a single integer
+    constexpr std::uint64_t value() const noexcept
+    {
+        return (static_cast<std::uint64_t>(generation_) << 32) | index_;
+    }
+
+    // a default constructed id never refers to an entity
+    explicit constexpr operator bool() const noexcept
+    {
+        return index_ != invalid_index;
+    }
+
+    constexpr bool operator==(const id& other) const noexcept
+    {
+        return index_ == other.index_ && generation_ == other.generation_;
+    }
+
+    constexpr bool operator!=(const id& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    constexpr bool operator<(const id& other) const noexcept
+    {
+        return value() < other.value();
+    }
+};
+} // namespace entity
+} // namespace aecs
+
+namespace std
+{
+template<>
+struct hash<aecs::entity::id>
+{
+    std::size_t operator()(const aecs::entity::id& e) const noexcept
+    {
+        return std::hash<std::uint64_t>{}(e.value());
+    }
+};
+} // namespace std
\ No newline at end of file
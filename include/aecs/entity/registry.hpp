@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "aecs/entity/id.hpp"
+
+namespace aecs
+{
+namespace entity
+{
+// where the components of an entity are stored, the archetype and the row
+// within that archetype.
+struct location
+{
+    std::uint32_t archetype;
+    std::uint32_t row;
+};
+
+// The sparse side of the entity mapping. Every entity index owns a slot which
+// stores the current generation and the location of the entity. Looking up an
+// entity is a single access into the slot array.
+//
+// Released slots are chained in a free list through their row, so create and
+// destroy are O(1) and indices are recycled.
+class registry
+{
+public:
+    static constexpr std::uint32_t dead = id::invalid_index;
+
+    struct slot
+    {
+        std::uint32_t generation;
+        // archetype is dead for released slots, row is then the next free slot
+        entity::location location;
+    };
+
+private:
+    std::vector<slot> slots_;
+    std::uint32_t     free_head_{dead};
+    std::size_t       size_{};
+
+public:
+    registry() = default;
+
+    // restore the slots and free list saved through slots() and free_head().
+    registry(std::vector<slot> slots, std::uint32_t free_head)
+        : slots_{std::move(slots)}, free_head_{free_head}
+    {
+        for (const auto& s : slots_)
+        {
+            size_ += s.location.archetype != dead;
+        }
+    }
+
+    // amount of alive entities
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    // amount of slots, alive or released
+    std::size_t capacity() const noexcept
+    {
+        return slots_.size();
+    }
+
+    // all capacity() slots, indexed by entity index.
+    const slot* slots() const noexcept
+    {
+        return slots_.data();
+    }
+
+    // the first released slot, or dead.
+    std::uint32_t free_head() const noexcept
+    {
+        return free_head_;
+    }
+
+    void reserve(std::size_t n)
+    {
+        slots_.reserve(n);
+    }
+
+    id create(entity::location loc)
+    {
+        assert(loc.archetype != dead && "invalid location");
+        ++size_;
+
+        if (free_head_ != dead)
+        {
+            const auto idx = free_head_;
+            auto&      s   = slots_[idx];
+            free_head_     = s.location.row;
+            s.location     = loc;
+            return id{idx, s.generation};
+        }
+
+        assert(slots_.size() < dead && "out of entity indices");
+        slots_.push_back(slot{0, loc});
+        return id{static_cast<std::uint32_t>(slots_.size() - 1), 0};
+    }
+
+    void destroy(id e) noexcept
+    {
+        assert(alive(e) && "entity is not alive");
+        auto& s = slots_[e.index()];
+
+        ++s.generation;
+        s.location = entity::location{dead, free_head_};
+        free_head_ = e.index();
+        --size_;
+    }
+
+    bool alive(id e) const noexcept
+    {
+        return e.index() < slots_.size() &&
+               slots_[e.index()].generation == e.generation() &&
+               slots_[e.index()].location.archetype != dead;
+    }
+
+    entity::location& locate(id e) noexcept
+    {
+        assert(alive(e) && "entity is not alive");
+        return slots_[e.index()].location;
+    }
+
+    const entity::location& locate(id e) const noexcept
+    {
+        assert(alive(e) && "entity is not alive");
+        return slots_[e.index()].location;
+    }
+};
+} // namespace entity
+} // namespace aecs
\ No newline at end of file
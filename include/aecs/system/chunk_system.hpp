@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aecs/component/traits.hpp"
+#include "aecs/container/algorithm.hpp"
+#include "aecs/entity/constraint.hpp"
+#include "aecs/system/static_schedule.hpp"
+#include "aecs/utility/inplace_function.hpp"
+#include "aecs/utility/thread_pool.hpp"
+#include "aecs/world/view.hpp"
+#include "aecs/world/world.hpp"
+
+namespace aecs
+{
+// The rows of a single column within a chunk, T is const for read access.
+template<typename T>
+class column_span
+{
+public:
+    using element_type = T;
+    using value_type   = std::remove_cv_t<T>;
+    using size_type    = std::size_t;
+    using pointer      = T*;
+    using reference    = T&;
+    using iterator     = T*;
+
+private:
+    T*        data_{nullptr};
+    size_type size_{};
+
+public:
+    constexpr column_span() noexcept = default;
+
+    constexpr column_span(T* data, size_type size) noexcept
+        : data_{data}, size_{size}
+    {}
+
+    constexpr T* data() const noexcept
+    {
+        return data_;
+    }
+
+    constexpr size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    constexpr T& operator[](size_type idx) const noexcept
+    {
+        assert(idx < size_);
+        return data_[idx];
+    }
+
+    constexpr iterator begin() const noexcept
+    {
+        return data_;
+    }
+
+    constexpr iterator end() const noexcept
+    {
+        return data_ + size_;
+    }
+};
+
+namespace detail
+{
+// the chunk argument of a constraint as a tuple, empty for exclude.
+template<typename Constraint>
+struct chunk_argument
+{
+    using component = typename Constraint::component_type;
+    using container = aecs::component_container_t<component>;
+
+    static_assert(Constraint::access_value == aecs::entity::access::exclude ||
+                      detail::has_data_v<container>,
+                  "chunk systems need columns with contiguous storage");
+
+    using type = std::conditional_t<
+        Constraint::access_value == aecs::entity::access::exclude,
+        std::tuple<>,
+        std::tuple<aecs::column_span<
+            std::conditional_t<Constraint::access_value ==
+                                   aecs::entity::access::read,
+                               const component,
+                               component>>>>;
+
+    static type make(const aecs::chunk& c) noexcept
+    {
+        if constexpr (std::tuple_size_v<type> == 0)
+        {
+            return {};
+        }
+        else
+        {
+            auto& col = c.template get<component>();
+            return type{{col.data() + c.begin(), c.size()}};
+        }
+    }
+};
+
+template<typename Tuple>
+struct chunk_signature;
+
+template<typename... Spans>
+struct chunk_signature<std::tuple<Spans...>>
+{
+    using type = void(Spans...);
+};
+} // namespace detail
+
+// A system which is invoked once per chunk with a column_span for every read
+// and write constraint, in the order of Constraints:
+//
+//   auto move = aecs::chunk_system<
+//       32,
+//       aecs::entity::static_constraint<access::write, position>,
+//       aecs::entity::static_constraint<access::read, velocity>>{
+//       [dt](aecs::column_span<position>       pos,
+//            aecs::column_span<const velocity> vel) {
+//           for (std::size_t i = 0; i != pos.size(); ++i)
+//           {
+//               pos[i].x += vel[i].dx * dt;
+//           }
+//       }};
+//
+// The callable is type erased in an inplace_function of Capacity bytes, so
+// the only indirect call happens per chunk and the loop over the rows is
+// compiled together with the callable. A chunk_system is itself a callable
+// taking a world and can be registered with a scheduler or static_schedule.
+template<std::size_t Capacity, typename... Constraints>
+class chunk_system
+{
+public:
+    using access = aecs::system_access<Constraints...>;
+
+    static constexpr auto constraints = access::constraints;
+
+private:
+    template<typename C>
+    using argument = detail::chunk_argument<C>;
+
+public:
+    // the column_spans passed to the callable, as a tuple
+    using arguments = decltype(std::tuple_cat(
+        std::declval<typename argument<Constraints>::type>()...));
+    using signature     = typename detail::chunk_signature<arguments>::type;
+    using function_type = aecs::inplace_function<signature, Capacity>;
+
+private:
+    function_type fn_;
+
+public:
+    template<typename F,
+             typename = std::enable_if_t<
+                 std::is_constructible_v<function_type, const F&>>>
+    constexpr explicit chunk_system(const F& fn) noexcept : fn_{fn}
+    {}
+
+    // call the system for a single chunk of a matching archetype.
+    void operator()(const aecs::chunk& c) const
+    {
+        std::apply(fn_, std::tuple_cat(argument<Constraints>::make(c)...));
+    }
+
+    // call the system for every matching chunk of w.
+    void operator()(aecs::world& w) const
+    {
+        aecs::view{w, constraints}.for_each(*this);
+    }
+
+    // the chunks are distributed over pool.
+    void operator()(aecs::world& w, aecs::thread_pool& pool) const
+    {
+        aecs::view{w, constraints}.parallel_for_each(pool, *this);
+    }
+};
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "aecs/component/mask.hpp"
+#include "aecs/component/registry.hpp"
+#include "aecs/entity/constraint.hpp"
+#include "aecs/utility/inplace_function.hpp"
+#include "aecs/utility/thread_pool.hpp"
+#include "aecs/utility/trace.hpp"
+#include "aecs/world/world.hpp"
+
+namespace aecs
+{
+// A registry of systems, each a callable together with the constraints
+// describing which components it accesses.
+//
+// Systems are ordered by registration. A system depends on every earlier
+// system it can't run in parallel with according to
+// constraint_view::allow_parallelism, everything else is free to overlap. run
+// executes this dependency graph on a thread_pool.
+//
+// Conflicts are checked on access_masks, so registering a system costs a few
+// word wise operations per earlier system.
+//
+// Systems are stored in an inplace_function of Capacity bytes, raise it for
+// systems capturing more state.
+//
+// A scheduler runs on one world at a time, it remembers which world it last
+// registered its components with.
+template<std::size_t Capacity>
+class basic_scheduler
+{
+public:
+    using system_fn = aecs::inplace_function<void(aecs::world&), Capacity>;
+
+    static constexpr std::size_t capacity = Capacity;
+
+private:
+    struct system
+    {
+        std::vector<aecs::entity::constraint> constraints;
+        aecs::access_mask<>                   mask;
+        system_fn                             fn;
+    };
+
+    std::vector<system> systems_;
+    // dense indices for the masks of all registered systems
+    aecs::component_registry components_;
+    // dependents_[i] are the systems which wait for system i
+    std::vector<std::vector<std::size_t>> dependents_;
+    std::vector<std::size_t>              dependency_count_;
+    // the world the components were last registered with, and the size of
+    // its registry after
+    mutable const aecs::world* registered_{nullptr};
+    mutable std::size_t        registered_size_{};
+
+public:
+    basic_scheduler() = default;
+
+    // register a system, returns its index.
+    template<std::size_t N, typename F>
+    std::size_t add_system(const aecs::entity::constraint_list<N>& cs, F&& fn)
+    {
+        const auto idx = systems_.size();
+
+        systems_.push_back(system{{cs.begin(), cs.end()},
+                                  components_.make_access_mask(cs),
+                                  system_fn{std::forward<F>(fn)}});
+        dependents_.emplace_back();
+        dependency_count_.push_back(0);
+        registered_ = nullptr;
+
+        const auto& mask = systems_[idx].mask;
+
+        for (std::size_t prev = 0; prev != idx; ++prev)
+        {
+            if (!systems_[prev].mask.allow_parallelism(mask))
+            {
+                dependents_[prev].push_back(idx);
+                ++dependency_count_[idx];
+            }
+        }
+
+        return idx;
+    }
+
+    // register a system which carries its constraints, such as a
+    // chunk_system.
+    template<typename System, typename = decltype(System::constraints)>
+    std::size_t add_system(const System& sys)
+    {
+        return add_system(System::constraints, sys);
+    }
+
+    std::size_t size() const noexcept
+    {
+        return systems_.size();
+    }
+
+    // true if system has to wait for dependency to finish.
+    bool depends_on(std::size_t system, std::size_t dependency) const noexcept
+    {
+        assert(system < size() && dependency < size());
+        const auto& deps = dependents_[dependency];
+        return std::find(deps.begin(), deps.end(), system) != deps.end();
+    }
+
+    // run every system on the calling thread in registration order.
+    void run(aecs::world& w) const
+    {
+        register_components(w);
+
+        for (std::size_t i = 0; i != systems_.size(); ++i)
+        {
+            AECS_TRACE_SCOPE("system", static_cast<std::int64_t>(i));
+            systems_[i].fn(w);
+        }
+    }
+
+    // run every system once, systems without dependencies between them run
+    // concurrently. Returns once all systems finished.
+    void run(aecs::world& w, aecs::thread_pool& pool) const
+    {
+        if (systems_.empty())
+        {
+            return;
+        }
+
+        register_components(w);
+
+        auto state = run_state{this, &w, &pool, systems_.size()};
+
+        for (std::size_t i = 0; i != systems_.size(); ++i)
+        {
+            state.remaining[i].store(dependency_count_[i],
+                                     std::memory_order_relaxed);
+        }
+
+        for (std::size_t i = 0; i != systems_.size(); ++i)
+        {
+            if (dependency_count_[i] == 0)
+            {
+                state.launch(i);
+            }
+        }
+
+        // help out until everything ran, state must outlive all tasks.
+        while (state.finished.load(std::memory_order_acquire) !=
+               systems_.size())
+        {
+            if (!pool.run_one())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    // views created by the systems only look up the components of w, register
+    // them while nothing else runs. Registries only grow, so this is skipped
+    // while w and the size of its registry stay the same.
+    void register_components(aecs::world& w) const
+    {
+        if (registered_ == &w && registered_size_ == w.components().size())
+        {
+            return;
+        }
+
+        for (const auto& s : systems_)
+        {
+            w.components().add(aecs::entity::constraint_view{
+                s.constraints.data(),
+                s.constraints.data() + s.constraints.size()});
+        }
+
+        registered_      = &w;
+        registered_size_ = w.components().size();
+    }
+
+    struct run_state
+    {
+        const basic_scheduler*                      sched;
+        aecs::world*                                world;
+        aecs::thread_pool*                          pool;
+        std::unique_ptr<std::atomic<std::size_t>[]> remaining;
+        std::atomic<std::size_t>                    finished{0};
+
+        run_state(const basic_scheduler* s,
+                  aecs::world*           w,
+                  aecs::thread_pool*     p,
+                  std::size_t            n)
+            : sched{s},
+              world{w},
+              pool{p},
+              remaining{std::make_unique<std::atomic<std::size_t>[]>(n)}
+        {}
+
+        void launch(std::size_t idx)
+        {
+            pool->submit([this, idx]() { execute(idx); });
+        }
+
+        void execute(std::size_t idx)
+        {
+            {
+                AECS_TRACE_SCOPE("system", static_cast<std::int64_t>(idx));
+                sched->systems_[idx].fn(*world);
+            }
+
+            for (auto d : sched->dependents_[idx])
+            {
+                if (remaining[d].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    launch(d);
+                }
+            }
+
+            finished.fetch_add(1, std::memory_order_release);
+        }
+    };
+};
+
+using scheduler = basic_scheduler<4 * sizeof(void*)>;
+} // namespace aecs
\ No newline at end of file
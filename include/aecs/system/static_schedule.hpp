@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "aecs/entity/constraint.hpp"
+#include "aecs/utility/thread_pool.hpp"
+#include "aecs/utility/trace.hpp"
+#include "aecs/world/world.hpp"
+
+namespace aecs
+{
+// The component accesses of a system, given as static_constraints so they're
+// known at compile time.
+template<typename... Constraints>
+struct system_access
+{
+    static constexpr auto constraints =
+        aecs::entity::constraint_list<sizeof...(Constraints)>{
+            Constraints{}...};
+
+    static constexpr aecs::entity::constraint_view view() noexcept
+    {
+        return aecs::entity::constraint_view{constraints};
+    }
+};
+
+// The schedule of a fixed set of systems, computed entirely at compile time.
+//
+// Like scheduler, a system has to wait for every earlier system it conflicts
+// with. Stages are assigned greedily in registration order, a system lands in
+// the first stage after all of its conflicting predecessors. Systems within a
+// stage never conflict and run concurrently, stages run one after another.
+template<typename... Systems>
+struct static_plan
+{
+    static constexpr std::size_t size = sizeof...(Systems);
+
+    using matrix_type = std::array<std::array<bool, size>, size>;
+
+    static constexpr auto views =
+        std::array<aecs::entity::constraint_view, size>{Systems::view()...};
+
+    // conflicts[i][j] is true if systems i and j can't run in parallel.
+    static constexpr matrix_type conflicts = []() {
+        auto res = matrix_type{};
+
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            for (std::size_t j = 0; j != size; ++j)
+            {
+                res[i][j] = i != j && !views[i].allow_parallelism(views[j]);
+            }
+        }
+
+        return res;
+    }();
+
+    // the stage every system runs in
+    static constexpr std::array<std::size_t, size> stages = []() {
+        auto res = std::array<std::size_t, size>{};
+
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            for (std::size_t prev = 0; prev != i; ++prev)
+            {
+                if (conflicts[prev][i] && res[prev] + 1 > res[i])
+                {
+                    res[i] = res[prev] + 1;
+                }
+            }
+        }
+
+        return res;
+    }();
+
+    static constexpr std::size_t stage_count = []() {
+        std::size_t res = 0;
+
+        for (auto s : stages)
+        {
+            res = s + 1 > res ? s + 1 : res;
+        }
+
+        return res;
+    }();
+
+    // system indices ordered by stage, registration order within a stage.
+    static constexpr std::array<std::size_t, size> order = []() {
+        auto        res = std::array<std::size_t, size>{};
+        std::size_t pos = 0;
+
+        for (std::size_t s = 0; s != stage_count; ++s)
+        {
+            for (std::size_t i = 0; i != size; ++i)
+            {
+                if (stages[i] == s)
+                {
+                    res[pos++] = i;
+                }
+            }
+        }
+
+        return res;
+    }();
+
+    // stage s consists of order[stage_offsets[s]] to
+    // order[stage_offsets[s + 1]].
+    static constexpr std::array<std::size_t, stage_count + 1> stage_offsets =
+        []() {
+            auto res = std::array<std::size_t, stage_count + 1>{};
+
+            for (auto s : stages)
+            {
+                ++res[s + 1];
+            }
+
+            for (std::size_t s = 0; s != stage_count; ++s)
+            {
+                res[s + 1] += res[s];
+            }
+
+            return res;
+        }();
+};
+
+// Binds the callables of a static_plan, one per system in the same order.
+// Running only replays the precomputed stages, nothing is allocated, hashed
+// or sorted. Only the first run on a world, or after its component registry
+// grew, registers the components of the systems with it.
+template<typename Plan, typename... Fs>
+class static_schedule
+{
+    static_assert(Plan::size == sizeof...(Fs),
+                  "every system needs exactly one callable");
+
+public:
+    using plan_type = Plan;
+
+private:
+    std::tuple<Fs...> systems_;
+    // the world the components were last registered with, and the size of
+    // its registry after
+    const aecs::world* registered_{nullptr};
+    std::size_t        registered_size_{};
+
+public:
+    template<typename... Us>
+    constexpr explicit static_schedule(Us&&... fns)
+        : systems_{std::forward<Us>(fns)...}
+    {}
+
+    static constexpr std::size_t size() noexcept
+    {
+        return Plan::size;
+    }
+
+    // run every system on the calling thread in execution order.
+    void run(aecs::world& w)
+    {
+        register_components(w);
+
+        for (auto idx : Plan::order)
+        {
+            invoke(idx, w);
+        }
+    }
+
+    // run stage after stage, the systems of a stage concurrently.
+    void run(aecs::world& w, aecs::thread_pool& pool)
+    {
+        register_components(w);
+
+        for (std::size_t s = 0; s != Plan::stage_count; ++s)
+        {
+            const auto first = Plan::stage_offsets[s];
+            const auto count = Plan::stage_offsets[s + 1] - first;
+
+            if (count == 1)
+            {
+                invoke(Plan::order[first], w);
+                continue;
+            }
+
+            pool.parallel_for(count, [&](std::size_t i) {
+                invoke(Plan::order[first + i], w);
+            });
+        }
+    }
+
+private:
+    // views created by the systems only look up the components of w, register
+    // them while nothing else runs. Registries only grow, so this is skipped
+    // while w and the size of its registry stay the same.
+    void register_components(aecs::world& w)
+    {
+        if (registered_ == &w && registered_size_ == w.components().size())
+        {
+            return;
+        }
+
+        for (auto cs : Plan::views)
+        {
+            w.components().add(cs);
+        }
+
+        registered_      = &w;
+        registered_size_ = w.components().size();
+    }
+
+    void invoke(std::size_t idx, aecs::world& w)
+    {
+        AECS_TRACE_SCOPE("system", static_cast<std::int64_t>(idx));
+        invoke(idx, w, std::index_sequence_for<Fs...>{});
+    }
+
+    template<std::size_t... Is>
+    void invoke(std::size_t idx, aecs::world& w, std::index_sequence<Is...>)
+    {
+        ((idx == Is ? (void)std::get<Is>(systems_)(w) : void()), ...);
+    }
+};
+
+template<typename... Systems, typename... Fs>
+constexpr auto make_static_schedule(Fs&&... fns)
+{
+    return static_schedule<static_plan<Systems...>, std::decay_t<Fs>...>{
+        std::forward<Fs>(fns)...};
+}
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace aecs
+{
+namespace detail
+{
+// converts to anything, used to probe how many initializers an aggregate
+// accepts.
+struct any_initializer
+{
+    template<typename U>
+    constexpr operator U() const noexcept;
+};
+
+template<typename T, typename Seq, typename = void>
+struct is_brace_constructible_n : std::false_type
+{};
+
+template<typename T, std::size_t... Is>
+struct is_brace_constructible_n<
+    T,
+    std::index_sequence<Is...>,
+    std::void_t<decltype(T{(void(Is), any_initializer{})...})>>
+    : std::true_type
+{};
+
+template<typename T, std::size_t N>
+constexpr std::size_t aggregate_arity_impl() noexcept
+{
+    if constexpr (N == 0)
+    {
+        return 0;
+    }
+    else if constexpr (is_brace_constructible_n<
+                           T,
+                           std::make_index_sequence<N>>::value)
+    {
+        return N;
+    }
+    else
+    {
+        return aggregate_arity_impl<T, N - 1>();
+    }
+}
+} // namespace detail
+
+// the largest amount of members supported by tie_members
+inline constexpr std::size_t max_aggregate_arity = 8;
+
+// number of direct members of the aggregate T, a nested aggregate counts as a
+// single member.
+//
+// The members are counted by probing how many initializers T accepts. A C
+// array member takes one initializer per element through brace elision, so
+// `struct { float v[3]; int id; }` counts 4 and tie_members fails to compile
+// for it. Use std::array for such members, which counts as one.
+template<typename T>
+inline constexpr std::size_t aggregate_arity_v =
+    detail::aggregate_arity_impl<T, max_aggregate_arity>();
+
+// return a tuple of references to every member of the aggregate t.
+template<typename T>
+constexpr auto tie_members(T& t) noexcept
+{
+    constexpr auto n = aggregate_arity_v<std::remove_cv_t<T>>;
+    static_assert(std::is_aggregate_v<std::remove_cv_t<T>>,
+                  "only aggregates can be split into members");
+    static_assert(n != 0, "aggregate must have at least one member");
+
+    if constexpr (n == 1)
+    {
+        auto& [m0] = t;
+        return std::tie(m0);
+    }
+    else if constexpr (n == 2)
+    {
+        auto& [m0, m1] = t;
+        return std::tie(m0, m1);
+    }
+    else if constexpr (n == 3)
+    {
+        auto& [m0, m1, m2] = t;
+        return std::tie(m0, m1, m2);
+    }
+    else if constexpr (n == 4)
+    {
+        auto& [m0, m1, m2, m3] = t;
+        return std::tie(m0, m1, m2, m3);
+    }
+    else if constexpr (n == 5)
+    {
+        auto& [m0, m1, m2, m3, m4] = t;
+        return std::tie(m0, m1, m2, m3, m4);
+    }
+    else if constexpr (n == 6)
+    {
+        auto& [m0, m1, m2, m3, m4, m5] = t;
+        return std::tie(m0, m1, m2, m3, m4, m5);
+    }
+    else if constexpr (n == 7)
+    {
+        auto& [m0, m1, m2, m3, m4, m5, m6] = t;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6);
+    }
+    else
+    {
+        static_assert(n == 8, "too many members");
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7] = t;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+    }
+}
+
+// the type of member I of the aggregate T
+template<std::size_t I, typename T>
+using aggregate_member_t = std::remove_reference_t<
+    std::tuple_element_t<I,
+                         decltype(aecs::tie_members(std::declval<T&>()))>>;
+} // namespace aecs
\ No newline at end of file
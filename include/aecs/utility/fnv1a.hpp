@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace aecs
+{
+// calculate the 64 bit FNV-1a hash of a string_view, followed by the murmur3
+// finalizer. This is a single multiply per character, so it's much cheaper
+// to evaluate at compile time than sha1, while the finalizer spreads the
+// entropy of similar names over all bits.
+//
+// The result is identical when computed at runtime, so hashes of names only
+// known at runtime match those of component_type<T>::hash().
+struct fnv1a_fn
+{
+private:
+    static constexpr std::uint64_t offset_basis = 0xcbf29ce484222325ull;
+    static constexpr std::uint64_t prime        = 0x100000001b3ull;
+
+    static constexpr std::uint64_t mix(std::uint64_t h) noexcept
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+public:
+    constexpr std::size_t operator()(std::string_view str) const noexcept
+    {
+        auto hash = offset_basis;
+
+        for (auto c : str)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= prime;
+        }
+
+        return static_cast<std::size_t>(mix(hash));
+    }
+};
+
+inline constexpr auto fnv1a = fnv1a_fn{};
+} // namespace aecs
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <new>
 #include <type_traits>
 
 namespace aecs
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "aecs/utility/fnv1a.hpp"
+#include "aecs/utility/sha1.hpp"
+
+namespace aecs
+{
+// the hash of component names, used for component_type<T>::hash() and to
+// hash names of components only known at runtime.
+//
+// FNV-1a is used by default, defining AECS_COMPONENT_HASH_SHA1 switches every
+// component hash to the truncated sha1 of older versions. The choice has to
+// be the same for the whole program.
+#ifdef AECS_COMPONENT_HASH_SHA1
+inline constexpr auto name_hash = aecs::sha1;
+#else
+inline constexpr auto name_hash = aecs::fnv1a;
+#endif
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace aecs
+{
+namespace detail
+{
+constexpr std::size_t ceil_pow2(std::size_t n) noexcept
+{
+    std::size_t res = 1;
+
+    while (res < n)
+    {
+        res <<= 1;
+    }
+
+    return res;
+}
+
+constexpr std::size_t log2_pow2(std::size_t n) noexcept
+{
+    std::size_t res = 0;
+
+    while ((std::size_t{1} << res) < n)
+    {
+        ++res;
+    }
+
+    return res;
+}
+} // namespace detail
+
+// A minimal lookup table for a set of N distinct 64 bit hashes which is known
+// at compile time, built in the style of CHD (hash, displace, compress).
+//
+// Keys are first distributed over buckets, then every bucket receives a
+// displacement which moves all of its keys to free positions of the table.
+// Buckets are placed from largest to smallest. Finding a key takes a bucket
+// lookup, an xor, multiply and shift and a comparison against the stored key.
+//
+// The table maps every key to its position in the array passed on
+// construction, unknown keys map to npos.
+template<std::size_t N>
+class perfect_hash
+{
+public:
+    static constexpr std::size_t npos = ~std::size_t{0};
+
+    // twice as many positions as keys keeps the search for displacements short
+    static constexpr std::size_t table_size =
+        detail::ceil_pow2(N == 0 ? 2 : 2 * N);
+    static constexpr std::size_t bucket_count = detail::ceil_pow2(N / 2 + 1);
+
+private:
+    static constexpr std::size_t table_shift =
+        64 - detail::log2_pow2(table_size);
+    static constexpr std::size_t bucket_shift =
+        64 - detail::log2_pow2(bucket_count);
+
+    // displacements tried per bucket before giving up, distinct keys need a
+    // handful at the load factor of table_size
+    static constexpr std::uint32_t max_displacement = 1u << 20;
+
+    // odd constants from splitmix64
+    static constexpr std::uint64_t bucket_mul = 0x9e3779b97f4a7c15ull;
+    static constexpr std::uint64_t table_mul  = 0xbf58476d1ce4e5b9ull;
+
+    std::array<std::uint32_t, bucket_count> displacements_{};
+    std::array<std::uint64_t, table_size>   keys_{};
+    std::array<std::uint32_t, table_size>   slots_{};
+
+public:
+    // keys must be distinct. Throws std::invalid_argument otherwise, which is
+    // a compile error when built in a constant expression.
+    constexpr explicit perfect_hash(const std::array<std::uint64_t, N>& keys)
+    {
+        constexpr auto empty = ~std::uint32_t{0};
+
+        for (std::size_t i = 0; i != N; ++i)
+        {
+            for (std::size_t j = 0; j != i; ++j)
+            {
+                if (keys[i] == keys[j])
+                {
+                    throw std::invalid_argument{
+                        "duplicate keys in perfect_hash"};
+                }
+            }
+        }
+
+        for (auto& s : slots_)
+        {
+            s = empty;
+        }
+
+        // members of every bucket
+        std::array<std::size_t, bucket_count> sizes{};
+        std::array<std::size_t, N>            members{};
+        std::array<std::size_t, bucket_count> starts{};
+
+        for (auto k : keys)
+        {
+            ++sizes[bucket(k)];
+        }
+
+        for (std::size_t b = 1; b < bucket_count; ++b)
+        {
+            starts[b] = starts[b - 1] + sizes[b - 1];
+        }
+
+        {
+            auto fill = starts;
+
+            for (std::size_t i = 0; i != N; ++i)
+            {
+                members[fill[bucket(keys[i])]++] = i;
+            }
+        }
+
+        // largest bucket first
+        std::array<std::size_t, bucket_count> order{};
+
+        for (std::size_t b = 0; b != bucket_count; ++b)
+        {
+            order[b] = b;
+        }
+
+        for (std::size_t i = 1; i < bucket_count; ++i)
+        {
+            for (auto j = i; j != 0 && sizes[order[j]] > sizes[order[j - 1]];
+                 --j)
+            {
+                auto tmp     = order[j];
+                order[j]     = order[j - 1];
+                order[j - 1] = tmp;
+            }
+        }
+
+        for (auto b : order)
+        {
+            if (sizes[b] == 0)
+            {
+                break;
+            }
+
+            const auto first = starts[b];
+            const auto last  = first + sizes[b];
+
+            for (std::uint32_t d = 0;; ++d)
+            {
+                if (d == max_displacement)
+                {
+                    throw std::length_error{
+                        "no displacement found in perfect_hash"};
+                }
+
+                // a displacement is valid if all positions are free and
+                // distinct
+                bool valid = true;
+
+                for (auto i = first; valid && i != last; ++i)
+                {
+                    const auto pos = position(keys[members[i]], d);
+                    valid          = slots_[pos] == empty;
+
+                    for (auto j = first; valid && j != i; ++j)
+                    {
+                        valid = position(keys[members[j]], d) != pos;
+                    }
+                }
+
+                if (valid)
+                {
+                    displacements_[b] = d;
+
+                    for (auto i = first; i != last; ++i)
+                    {
+                        const auto pos = position(keys[members[i]], d);
+                        keys_[pos]     = keys[members[i]];
+                        slots_[pos]    = static_cast<std::uint32_t>(members[i]);
+                    }
+
+                    break;
+                }
+            }
+        }
+    }
+
+    static constexpr std::size_t size() noexcept
+    {
+        return N;
+    }
+
+    // the index of key in the construction array, or npos.
+    constexpr std::size_t find(std::uint64_t key) const noexcept
+    {
+        const auto pos  = position(key, displacements_[bucket(key)]);
+        const auto slot = slots_[pos];
+
+        return slot != ~std::uint32_t{0} && keys_[pos] == key ? slot : npos;
+    }
+
+    constexpr bool contains(std::uint64_t key) const noexcept
+    {
+        return find(key) != npos;
+    }
+
+private:
+    static constexpr std::size_t bucket(std::uint64_t key) noexcept
+    {
+        if constexpr (bucket_count == 1)
+        {
+            return 0;
+        }
+        else
+        {
+            return static_cast<std::size_t>((key * bucket_mul) >>
+                                            bucket_shift);
+        }
+    }
+
+    static constexpr std::size_t position(std::uint64_t key,
+                                          std::uint32_t d) noexcept
+    {
+        // the xor makes the positions of a pair of keys vary independently
+        // between displacements, a plain offset would keep their distance.
+        const auto mixed = (key ^ (d * bucket_mul)) * table_mul;
+        return static_cast<std::size_t>(mixed >> table_shift);
+    }
+};
+
+template<std::size_t N>
+perfect_hash(const std::array<std::uint64_t, N>&)->perfect_hash<N>;
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "aecs/utility/thread_pool.hpp"
+
+// Sorting row indices by 64 bit keys, used to reorder the rows of archetypes.
+//
+// Keys are sorted with a stable LSD radix sort of 8 bit digits. Passes where
+// every key has the same digit, such as the unused high bits of small keys,
+// are skipped. With a thread_pool the keys are split in parts, every part
+// counts its digits and scatters its keys to the offsets of its own, so the
+// result is identical to the serial sort.
+namespace aecs
+{
+enum class sort_mode
+{
+    // radix sort all keys
+    full,
+    // for keys which are mostly sorted already, for example sorted by a
+    // previous call with a few entities moved since. The keys breaking the
+    // ascending order are sorted on their own and merged back in, if there
+    // are too many of them this falls back to full.
+    incremental
+};
+
+namespace detail
+{
+namespace radix
+{
+struct item
+{
+    std::uint64_t key;
+    std::size_t   index;
+};
+
+constexpr std::size_t digit_bits = 8;
+constexpr std::size_t buckets    = std::size_t{1} << digit_bits;
+constexpr std::size_t passes     = 64 / digit_bits;
+
+// parts smaller than this aren't worth handing to another thread
+constexpr std::size_t min_part_size = std::size_t{1} << 14;
+
+// incremental gives up once more than 1 / straggler_ratio keys are unordered
+constexpr std::size_t straggler_ratio = 8;
+
+inline std::size_t digit(std::uint64_t key, std::size_t pass) noexcept
+{
+    return (key >> (pass * digit_bits)) & (buckets - 1);
+}
+
+// sort items by key, stable. for_parts(parts, fn) has to call fn(p) for every
+// p in [0, parts) and return once all calls finished.
+template<typename ForParts>
+void sort(std::vector<item>& items,
+          std::vector<item>& tmp,
+          std::size_t        parts,
+          ForParts&&         for_parts)
+{
+    const auto n = items.size();
+
+    if (n < 2)
+    {
+        return;
+    }
+
+    tmp.resize(n);
+
+    auto counts = std::vector<std::array<std::size_t, buckets>>(parts);
+    auto first  = [&](std::size_t p) { return n * p / parts; };
+
+    for (std::size_t pass = 0; pass != passes; ++pass)
+    {
+        for_parts(parts, [&](std::size_t p) {
+            auto& count = counts[p];
+            count.fill(0);
+
+            for (auto i = first(p); i != first(p + 1); ++i)
+            {
+                ++count[digit(items[i].key, pass)];
+            }
+        });
+
+        // every key has the same digit, nothing moves
+        std::size_t same = 0;
+
+        for (const auto& count : counts)
+        {
+            same += count[digit(items[0].key, pass)];
+        }
+
+        if (same == n)
+        {
+            continue;
+        }
+
+        // turn the counts into the first position of every part and digit,
+        // lower parts go first within a digit which keeps the sort stable
+        std::size_t offset = 0;
+
+        for (std::size_t b = 0; b != buckets; ++b)
+        {
+            for (auto& count : counts)
+            {
+                offset += std::exchange(count[b], offset);
+            }
+        }
+
+        for_parts(parts, [&](std::size_t p) {
+            auto& pos = counts[p];
+
+            for (auto i = first(p); i != first(p + 1); ++i)
+            {
+                tmp[pos[digit(items[i].key, pass)]++] = items[i];
+            }
+        });
+
+        items.swap(tmp);
+    }
+}
+
+template<typename ForParts>
+void sort_order(const std::uint64_t*      keys,
+                std::size_t               n,
+                std::vector<std::size_t>& order,
+                aecs::sort_mode           mode,
+                std::size_t               parts,
+                ForParts&&                for_parts)
+{
+    auto items = std::vector<item>{};
+    auto tmp   = std::vector<item>{};
+
+    order.resize(n);
+
+    if (mode == aecs::sort_mode::incremental)
+    {
+        // keep the keys which continue the ascending run of kept keys, the
+        // stragglers are sorted and merged back in. A key greater than its
+        // successor is a straggler as well, so a single large key doesn't
+        // turn every key after it into one.
+        auto kept = std::vector<item>{};
+        kept.reserve(n);
+
+        for (std::size_t i = 0; i != n; ++i)
+        {
+            if ((kept.empty() || kept.back().key <= keys[i]) &&
+                (i + 1 == n || keys[i] <= keys[i + 1]))
+            {
+                kept.push_back(item{keys[i], i});
+            }
+            else if (items.size() < n / straggler_ratio)
+            {
+                items.push_back(item{keys[i], i});
+            }
+            else
+            {
+                mode = aecs::sort_mode::full;
+                break;
+            }
+        }
+
+        if (mode == aecs::sort_mode::incremental)
+        {
+            // few enough to not bother other threads
+            sort(items, tmp, 1, [](std::size_t, auto&& fn) { fn(0); });
+
+            // kept and items are both ordered by key and then index, so
+            // merging by both keeps equal keys in their original order.
+            tmp.resize(n);
+            std::merge(kept.begin(),
+                       kept.end(),
+                       items.begin(),
+                       items.end(),
+                       tmp.begin(),
+                       [](const item& lhs, const item& rhs) {
+                           return lhs.key < rhs.key ||
+                                  (lhs.key == rhs.key &&
+                                   lhs.index < rhs.index);
+                       });
+
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                order[i] = tmp[i].index;
+            }
+
+            return;
+        }
+
+        items.clear();
+    }
+
+    items.resize(n);
+
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        items[i] = item{keys[i], i};
+    }
+
+    sort(items, tmp, parts, for_parts);
+
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        order[i] = items[i].index;
+    }
+}
+} // namespace radix
+} // namespace detail
+
+// Write the positions of the n keys in ascending order to order, so that
+// keys[order[0]] <= keys[order[1]] <= .... Equal keys keep their order.
+inline void sort_order(const std::uint64_t*      keys,
+                       std::size_t               n,
+                       std::vector<std::size_t>& order,
+                       aecs::sort_mode           mode = aecs::sort_mode::full)
+{
+    detail::radix::sort_order(
+        keys, n, order, mode, 1, [](std::size_t, auto&& fn) { fn(0); });
+}
+
+// the same, with the counting and scattering of every pass spread over pool.
+inline void sort_order(aecs::thread_pool&        pool,
+                       const std::uint64_t*      keys,
+                       std::size_t               n,
+                       std::vector<std::size_t>& order,
+                       aecs::sort_mode           mode = aecs::sort_mode::full)
+{
+    const auto parts = std::clamp<std::size_t>(
+        n / detail::radix::min_part_size, 1, pool.size() + 1);
+
+    detail::radix::sort_order(
+        keys, n, order, mode, parts, [&](std::size_t count, auto&& fn) {
+            pool.parallel_for(count, fn);
+        });
+}
+} // namespace aecs
\ No newline at end of file
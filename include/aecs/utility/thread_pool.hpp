@@ -0,0 +1,302 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "aecs/utility/inplace_function.hpp"
+
+namespace aecs
+{
+// A fixed set of worker threads executing tasks. Tasks are inplace_functions,
+// so they have to be trivially copyable and small. Capturing a pointer to a
+// larger state object is the usual way around this.
+//
+// Every worker owns a deque. Tasks submitted from a worker go to its own
+// deque and are popped LIFO, which keeps related work on the same core. Idle
+// workers steal FIFO from the other deques. Tasks submitted from outside the
+// pool go to a shared deque which everyone takes from.
+class thread_pool
+{
+public:
+    using task = aecs::inplace_function<void(), 4 * sizeof(void*)>;
+
+    // returned by current_index() on threads which aren't part of a pool.
+    static constexpr std::size_t external_index = ~std::size_t{0};
+
+private:
+    struct task_queue
+    {
+        std::mutex       mutex;
+        std::deque<task> tasks;
+    };
+
+    struct worker_identity
+    {
+        const thread_pool* pool{nullptr};
+        std::size_t        index{external_index};
+    };
+
+    std::vector<std::thread> workers_;
+    // one per worker, the last one is shared by external threads
+    std::vector<std::unique_ptr<task_queue>> queues_;
+    std::atomic<std::size_t>                 queued_{0};
+    std::mutex                               sleep_mutex_;
+    std::condition_variable                  cv_;
+    bool                                     stopping_{false};
+
+    static worker_identity& identity() noexcept
+    {
+        static thread_local worker_identity id{};
+        return id;
+    }
+
+public:
+    // the calling thread always participates in parallel_for, so by default
+    // one thread less than the hardware supports is started.
+    explicit thread_pool(std::size_t threads = default_thread_count())
+    {
+        queues_.reserve(threads + 1);
+
+        for (std::size_t i = 0; i != threads + 1; ++i)
+        {
+            queues_.push_back(std::make_unique<task_queue>());
+        }
+
+        workers_.reserve(threads);
+
+        for (std::size_t i = 0; i != threads; ++i)
+        {
+            workers_.emplace_back([this, i]() { run_worker(i); });
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{sleep_mutex_};
+            stopping_ = true;
+        }
+
+        cv_.notify_all();
+
+        for (auto& w : workers_)
+        {
+            w.join();
+        }
+    }
+
+    static std::size_t default_thread_count() noexcept
+    {
+        const auto hw = std::thread::hardware_concurrency();
+        return hw > 1 ? hw - 1 : 0;
+    }
+
+    // amount of worker threads
+    std::size_t size() const noexcept
+    {
+        return workers_.size();
+    }
+
+    // index of the calling worker in [0, size()), or external_index.
+    static std::size_t current_index() noexcept
+    {
+        return identity().index;
+    }
+
+    // the pool the calling thread is a worker of, or null.
+    static const thread_pool* current_pool() noexcept
+    {
+        return identity().pool;
+    }
+
+    void submit(task t)
+    {
+        auto& q = *queues_[own_queue()];
+
+        {
+            std::lock_guard<std::mutex> lock{q.mutex};
+            q.tasks.push_back(t);
+        }
+
+        queued_.fetch_add(1, std::memory_order_release);
+
+        {
+            // pairs with the predicate check of sleeping workers
+            std::lock_guard<std::mutex> lock{sleep_mutex_};
+        }
+
+        cv_.notify_one();
+    }
+
+    // run a single queued task on the calling thread, returns false if there
+    // was nothing to run.
+    bool run_one()
+    {
+        task t;
+
+        if (!try_pop(own_queue(), t))
+        {
+            return false;
+        }
+
+        t();
+        return true;
+    }
+
+    // call fn(i) for every i in [0, n) and return once all calls finished.
+    // The calling thread takes part, while waiting it runs other queued tasks
+    // so nested parallel_for calls from within a task can't deadlock.
+    template<typename F>
+    void parallel_for(std::size_t n, F&& fn)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+
+        struct job
+        {
+            std::remove_reference_t<F>* fn;
+            std::size_t                 n;
+            std::atomic<std::size_t>    next{0};
+            std::atomic<std::size_t>    pending_helpers{0};
+
+            void work()
+            {
+                for (auto i = next.fetch_add(1, std::memory_order_relaxed);
+                     i < n;
+                     i = next.fetch_add(1, std::memory_order_relaxed))
+                {
+                    (*fn)(i);
+                }
+            }
+        };
+
+        auto j = job{std::addressof(fn), n};
+
+        const auto helpers = std::min(size(), n - 1);
+        j.pending_helpers.store(helpers, std::memory_order_relaxed);
+
+        for (std::size_t h = 0; h != helpers; ++h)
+        {
+            submit([jp = &j]() {
+                jp->work();
+                jp->pending_helpers.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        j.work();
+
+        // the job lives on this stack frame, wait for every helper to let go.
+        while (j.pending_helpers.load(std::memory_order_acquire) != 0)
+        {
+            if (!run_one())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    std::size_t own_queue() const noexcept
+    {
+        const auto& id = identity();
+        return id.pool == this ? id.index : queues_.size() - 1;
+    }
+
+    static bool pop_front(task_queue& q, task& out)
+    {
+        std::lock_guard<std::mutex> lock{q.mutex};
+
+        if (q.tasks.empty())
+        {
+            return false;
+        }
+
+        out = q.tasks.front();
+        q.tasks.pop_front();
+        return true;
+    }
+
+    static bool pop_back(task_queue& q, task& out)
+    {
+        std::lock_guard<std::mutex> lock{q.mutex};
+
+        if (q.tasks.empty())
+        {
+            return false;
+        }
+
+        out = q.tasks.back();
+        q.tasks.pop_back();
+        return true;
+    }
+
+    // own deque LIFO first, then the shared deque, then steal from the others.
+    bool try_pop(std::size_t own, task& out)
+    {
+        if (queued_.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+
+        const auto shared = queues_.size() - 1;
+        auto       found  = own != shared && pop_back(*queues_[own], out);
+
+        for (std::size_t i = 0; !found && i != queues_.size(); ++i)
+        {
+            const auto victim = (shared + i) % queues_.size();
+
+            if (victim != own || own == shared)
+            {
+                found = pop_front(*queues_[victim], out);
+            }
+        }
+
+        if (found)
+        {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        return found;
+    }
+
+    void run_worker(std::size_t idx)
+    {
+        identity() = worker_identity{this, idx};
+
+        while (true)
+        {
+            task t;
+
+            if (try_pop(idx, t))
+            {
+                t();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{sleep_mutex_};
+            cv_.wait(lock, [this]() {
+                return stopping_ ||
+                       queued_.load(std::memory_order_acquire) != 0;
+            });
+
+            if (stopping_ && queued_.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+        }
+    }
+};
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef AECS_ENABLE_TRACING
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#else
+#include <cstdio>
+#endif
+
+// AECS_TRACE_SCOPE(name[, id]) records the time until the end of the
+// enclosing scope as an event. name has to be a string literal, id is an
+// optional number shown in the event arguments. Without AECS_ENABLE_TRACING
+// the macro expands to nothing.
+#ifdef AECS_ENABLE_TRACING
+#define AECS_TRACE_CONCAT_IMPL(a, b) a##b
+#define AECS_TRACE_CONCAT(a, b) AECS_TRACE_CONCAT_IMPL(a, b)
+#define AECS_TRACE_SCOPE(...)                                                  \
+    const ::aecs::trace::scope AECS_TRACE_CONCAT(aecs_trace_scope_,            \
+                                                 __LINE__)                     \
+    {                                                                          \
+        __VA_ARGS__                                                            \
+    }
+#else
+#define AECS_TRACE_SCOPE(...) static_cast<void>(0)
+#endif
+
+namespace aecs
+{
+namespace trace
+{
+constexpr bool enabled() noexcept
+{
+#ifdef AECS_ENABLE_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef AECS_ENABLE_TRACING
+struct event
+{
+    const char*   name;
+    std::int64_t  id;
+    std::uint64_t begin;
+    std::uint64_t end;
+};
+
+// nanoseconds since the first call
+inline std::uint64_t now() noexcept
+{
+    using clock = std::chrono::steady_clock;
+    static const auto epoch = clock::now();
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             epoch)
+            .count());
+}
+
+// The events of a single thread. Only the owning thread pushes, once full the
+// oldest events are overwritten. Reading is only reliable while the owning
+// thread isn't recording.
+class ring
+{
+public:
+    static constexpr std::size_t capacity = std::size_t{1} << 14;
+
+private:
+    std::unique_ptr<event[]>   events_{new event[capacity]};
+    std::atomic<std::uint64_t> head_{0};
+    std::uint32_t              thread_;
+
+public:
+    explicit ring(std::uint32_t thread) noexcept : thread_{thread}
+    {}
+
+    std::uint32_t thread() const noexcept
+    {
+        return thread_;
+    }
+
+    void push(const event& e) noexcept
+    {
+        const auto h                = head_.load(std::memory_order_relaxed);
+        events_[h & (capacity - 1)] = e;
+        head_.store(h + 1, std::memory_order_release);
+    }
+
+    void clear() noexcept
+    {
+        head_.store(0, std::memory_order_release);
+    }
+
+    // call fn(event) for all stored events, oldest first.
+    template<typename F>
+    void for_each(F&& fn) const
+    {
+        const auto h     = head_.load(std::memory_order_acquire);
+        const auto first = h > capacity ? h - capacity : 0;
+
+        for (auto i = first; i != h; ++i)
+        {
+            fn(events_[i & (capacity - 1)]);
+        }
+    }
+};
+
+namespace detail
+{
+// Owns the ring of every thread which ever recorded. Rings are never
+// destroyed, so the events of finished threads can still be written out.
+class ring_registry
+{
+private:
+    std::mutex                         mutex_;
+    std::vector<std::unique_ptr<ring>> rings_;
+
+public:
+    static ring_registry& instance()
+    {
+        static ring_registry reg;
+        return reg;
+    }
+
+    // the lock is only taken the first time a thread records
+    ring& local()
+    {
+        static thread_local ring* r = [this]() {
+            std::lock_guard<std::mutex> lock{mutex_};
+            rings_.push_back(std::make_unique<ring>(
+                static_cast<std::uint32_t>(rings_.size())));
+            return rings_.back().get();
+        }();
+
+        return *r;
+    }
+
+    template<typename F>
+    void for_each(F&& fn)
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+
+        for (const auto& r : rings_)
+        {
+            fn(*r);
+        }
+    }
+};
+
+inline void write_escaped(std::ostream& os, const char* str)
+{
+    for (; *str != '\0'; ++str)
+    {
+        if (*str == '"' || *str == '\\')
+        {
+            os << '\\';
+        }
+
+        os << *str;
+    }
+}
+} // namespace detail
+
+inline void record(const event& e)
+{
+    detail::ring_registry::instance().local().push(e);
+}
+
+// records an event from construction to destruction
+class scope
+{
+private:
+    const char*   name_;
+    std::int64_t  id_;
+    std::uint64_t begin_;
+
+public:
+    explicit scope(const char* name, std::int64_t id = -1) noexcept
+        : name_{name}, id_{id}, begin_{now()}
+    {}
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+    ~scope()
+    {
+        record(event{name_, id_, begin_, now()});
+    }
+};
+
+// drop all recorded events, no thread may be recording.
+inline void clear()
+{
+    detail::ring_registry::instance().for_each([](ring& r) { r.clear(); });
+}
+
+// amount of recorded events over all threads
+inline std::size_t size()
+{
+    std::size_t res = 0;
+    detail::ring_registry::instance().for_each(
+        [&](ring& r) { r.for_each([&](const event&) { ++res; }); });
+    return res;
+}
+
+// write all events in the chrome trace event format, as complete ("X")
+// events in microseconds. No thread may be recording.
+inline void write_chrome_json(std::ostream& os)
+{
+    os << "{\"traceEvents\":[";
+    auto first = true;
+
+    detail::ring_registry::instance().for_each([&](ring& r) {
+        r.for_each([&](const event& e) {
+            os << (first ? "\n" : ",\n") << "{\"name\":\"";
+            detail::write_escaped(os, e.name);
+            os << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << r.thread()
+               << ",\"ts\":" << e.begin / 1000 << '.' << e.begin % 1000 / 100
+               << ",\"dur\":" << (e.end - e.begin) / 1000 << '.'
+               << (e.end - e.begin) % 1000 / 100;
+
+            if (e.id >= 0)
+            {
+                os << ",\"args\":{\"id\":" << e.id << '}';
+            }
+
+            os << '}';
+            first = false;
+        });
+    });
+
+    os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+// write_chrome_json to the file at path, returns false if it can't be opened.
+inline bool dump(const char* path)
+{
+    auto file = std::ofstream{path};
+
+    if (!file)
+    {
+        return false;
+    }
+
+    write_chrome_json(file);
+    return static_cast<bool>(file);
+}
+#else
+inline void clear() noexcept
+{}
+
+inline std::size_t size() noexcept
+{
+    return 0;
+}
+
+// any std::ostream, a template so disabled builds don't include <ostream>
+template<typename OStream>
+void write_chrome_json(OStream& os)
+{
+    os << "{\"traceEvents\":[]}\n";
+}
+
+// an empty trace, through <cstdio> for the same reason
+inline bool dump(const char* path)
+{
+    auto* file = std::fopen(path, "w");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    const auto ok = std::fputs("{\"traceEvents\":[]}\n", file) >= 0;
+    return std::fclose(file) == 0 && ok;
+}
+#endif
+} // namespace trace
+} // namespace aecs
\ No newline at end of file
@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "aecs/component/type.hpp"
+#include "aecs/container/archetype.hpp"
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/wrapped.hpp"
+#include "aecs/entity/id.hpp"
+#include "aecs/utility/inplace_function.hpp"
+#include "aecs/utility/thread_pool.hpp"
+#include "aecs/utility/trace.hpp"
+#include "aecs/world/world.hpp"
+
+namespace aecs
+{
+// Records structural changes while systems iterate and applies them later at
+// a sync point through flush.
+//
+// Every worker of the thread_pool the buffer was created for records into its
+// own lane, so recording takes no locks. All other threads, including the
+// workers of other pools, share the last lane behind a mutex. Commands of the
+// same kind are stored together, spawned components in staging archetypes
+// and added components in a column per component type. flush applies them
+// in batches through the bulk operations of world, in the order spawn, add,
+// remove, destroy and custom commands.
+//
+// Spawned entities only receive their id during flush, so they can't be
+// referenced by other commands of the same buffer.
+class command_buffer
+{
+public:
+    using command = aecs::inplace_function<void(aecs::world&),
+                                           4 * sizeof(void*)>;
+
+private:
+    struct add_batch
+    {
+        // component values, element i belongs to entities[i]
+        std::unique_ptr<aecs::polymorphic_container> values;
+        std::vector<aecs::entity::id>                entities;
+    };
+
+    struct remove_batch
+    {
+        std::size_t                   hash;
+        std::vector<aecs::entity::id> entities;
+    };
+
+    struct alignas(64) lane
+    {
+        std::map<std::vector<std::size_t>, aecs::archetype> spawns;
+        std::vector<add_batch>                              adds;
+        std::vector<remove_batch>                           removes;
+        std::vector<aecs::entity::id>                       destroys;
+        std::vector<command>                                commands;
+    };
+
+    // a lane together with the lock of the shared lane, if that's the one.
+    struct locked_lane
+    {
+        lane&                        ref;
+        std::unique_lock<std::mutex> lock;
+    };
+
+    const aecs::thread_pool* pool_{nullptr};
+    // one per worker of pool_, the last one is shared
+    std::vector<lane> lanes_;
+    std::mutex        shared_mutex_;
+
+public:
+    // only the shared lane.
+    command_buffer() : lanes_(1)
+    {}
+
+    // a lane for each worker of pool plus the shared one.
+    explicit command_buffer(const aecs::thread_pool& pool)
+        : pool_{&pool}, lanes_(pool.size() + 1)
+    {}
+
+    command_buffer(const command_buffer&) = delete;
+    command_buffer& operator=(const command_buffer&) = delete;
+
+    // true if nothing was recorded since the last flush.
+    bool empty() const noexcept
+    {
+        return std::all_of(lanes_.begin(), lanes_.end(), [](const lane& l) {
+            return l.adds.empty() && l.removes.empty() &&
+                   l.destroys.empty() && l.commands.empty() &&
+                   std::all_of(l.spawns.begin(),
+                               l.spawns.end(),
+                               [](const auto& s) { return s.second.empty(); });
+        });
+    }
+
+    // create an entity with the passed components during flush.
+    template<typename... Ts>
+    void spawn(Ts&&... components)
+    {
+        auto cur = current();
+
+        // the id is assigned by world::spawn
+        staging<std::remove_cv_t<std::remove_reference_t<Ts>>...>(cur.ref)
+            .push_back(aecs::entity::id{}, std::forward<Ts>(components)...);
+    }
+
+    void destroy(aecs::entity::id e)
+    {
+        auto cur = current();
+        cur.ref.destroys.push_back(e);
+    }
+
+    // add T(args...) to e, overwriting an existing T.
+    template<typename T, typename... Args>
+    void add(aecs::entity::id e, Args&&... args)
+    {
+        auto       cur  = current();
+        auto&      adds = cur.ref.adds;
+        const auto hash = aecs::component_type<T>::hash();
+
+        auto it = std::find_if(adds.begin(), adds.end(), [&](const auto& b) {
+            return b.values->component_hash() == hash;
+        });
+
+        if (it == adds.end())
+        {
+            adds.push_back(
+                add_batch{std::make_unique<aecs::wrapped_container<T>>(), {}});
+            it = adds.end() - 1;
+        }
+
+        it->values->template push_back<T>(std::forward<Args>(args)...);
+        it->entities.push_back(e);
+    }
+
+    template<typename T>
+    void remove(aecs::entity::id e)
+    {
+        auto       cur     = current();
+        auto&      removes = cur.ref.removes;
+        const auto hash    = aecs::component_type<T>::hash();
+
+        auto it =
+            std::find_if(removes.begin(), removes.end(), [&](const auto& b) {
+                return b.hash == hash;
+            });
+
+        if (it == removes.end())
+        {
+            removes.push_back(remove_batch{hash, {}});
+            it = removes.end() - 1;
+        }
+
+        it->entities.push_back(e);
+    }
+
+    // run fn(world) during flush, after all other commands.
+    template<typename F>
+    void push(F&& fn)
+    {
+        auto cur = current();
+        cur.ref.commands.emplace_back(std::forward<F>(fn));
+    }
+
+    // apply and clear all recorded commands, must not run concurrently with
+    // any recording or iteration of w.
+    void flush(aecs::world& w)
+    {
+        AECS_TRACE_SCOPE("flush");
+
+        {
+            AECS_TRACE_SCOPE("flush spawns");
+
+            for (auto& l : lanes_)
+            {
+                for (auto& s : l.spawns)
+                {
+                    w.spawn(s.second);
+                }
+            }
+        }
+
+        {
+            AECS_TRACE_SCOPE("flush adds");
+
+            for (auto& l : lanes_)
+            {
+                for (auto& b : l.adds)
+                {
+                    w.add(*b.values, b.entities.data(), b.entities.size());
+                }
+
+                l.adds.clear();
+            }
+        }
+
+        {
+            AECS_TRACE_SCOPE("flush removes");
+
+            for (auto& l : lanes_)
+            {
+                for (auto& b : l.removes)
+                {
+                    w.remove(b.hash, b.entities.data(), b.entities.size());
+                }
+
+                l.removes.clear();
+            }
+        }
+
+        {
+            AECS_TRACE_SCOPE("flush destroys");
+
+            // merged, so each archetype is compacted only once
+            auto destroys = std::vector<aecs::entity::id>{};
+
+            for (auto& l : lanes_)
+            {
+                destroys.insert(
+                    destroys.end(), l.destroys.begin(), l.destroys.end());
+                l.destroys.clear();
+            }
+
+            w.destroy(destroys.data(), destroys.size());
+        }
+
+        AECS_TRACE_SCOPE("flush commands");
+
+        for (auto& l : lanes_)
+        {
+            for (auto& c : l.commands)
+            {
+                c(w);
+            }
+
+            l.commands.clear();
+        }
+    }
+
+private:
+    // the lane of the calling thread, the shared one is locked until the
+    // returned value is destroyed.
+    locked_lane current()
+    {
+        if (pool_ && aecs::thread_pool::current_pool() == pool_)
+        {
+            return locked_lane{lanes_[aecs::thread_pool::current_index()], {}};
+        }
+
+        return locked_lane{lanes_.back(),
+                           std::unique_lock<std::mutex>{shared_mutex_}};
+    }
+
+    // the staging archetype of l storing Ts.
+    template<typename... Ts>
+    aecs::archetype& staging(lane& l)
+    {
+        static const auto sig = []() {
+            auto res =
+                std::vector<std::size_t>{aecs::component_type<Ts>::hash()...};
+            std::sort(res.begin(), res.end());
+            return res;
+        }();
+
+        auto& spawns = l.spawns;
+        auto  it     = spawns.find(sig);
+
+        if (it == spawns.end())
+        {
+            it = spawns.emplace(sig, aecs::archetype{std::in_place_type<Ts>...})
+                     .first;
+        }
+
+        return it->second;
+    }
+};
+} // namespace aecs
\ No newline at end of file
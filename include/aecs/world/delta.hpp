@@ -0,0 +1,582 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+#include "aecs/container/archetype.hpp"
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/entity/id.hpp"
+#include "aecs/world/world.hpp"
+
+// Delta replication of component values.
+//
+// Both sides keep a delta_baseline, the component values of every entity as
+// of the last delta. encode_delta visits the chunks changed since a world
+// version, compares their rows with the baseline and emits a record per
+// chunk and column listing the entities whose value changed. Values are
+// XORed with the baseline, so unchanged bytes become zero, and the zero runs
+// are run-length encoded. apply_delta reverses this and writes the values in
+// bulk through polymorphic_container.
+//
+// Only values are replicated, entities and their components have to exist on
+// the receiving side already, records for anything else are skipped. Columns
+// without a per element raw representation, such as tags and bit packed
+// tags, carry no values and are never part of a delta.
+namespace aecs
+{
+// The last replicated value of every entity and component. Sender and
+// receiver have to start from equal baselines, each delta moves both to the
+// same new state. To resend after a lost delta, encode against a copy of the
+// baseline of the last acknowledged delta.
+//
+// Values are stored per component in an array indexed by entity index, ids
+// are equal on both sides while rows are not. An index reused by a new
+// generation takes over the slot of the old one, so the storage is bounded
+// by the highest entity index rather than the amount of entities ever seen.
+class delta_baseline
+{
+public:
+    // the values of a single component
+    class column
+    {
+    private:
+        std::size_t                   element_size_;
+        // the entity owning every slot of values_, invalid for free slots
+        std::vector<aecs::entity::id> owners_;
+        std::vector<unsigned char>    values_;
+
+    public:
+        explicit column(std::size_t element_size) noexcept
+            : element_size_{element_size}
+        {}
+
+        std::size_t element_size() const noexcept
+        {
+            return element_size_;
+        }
+
+        // the stored value of e, or nullptr.
+        const unsigned char* find(aecs::entity::id e) const noexcept
+        {
+            const auto idx = e.index();
+            return idx < owners_.size() && owners_[idx] == e
+                       ? values_.data() + idx * element_size_
+                       : nullptr;
+        }
+
+        // the stored value of e, which is inserted as all zero bytes if
+        // missing.
+        unsigned char* get(aecs::entity::id e)
+        {
+            const auto idx = e.index();
+
+            if (idx >= owners_.size())
+            {
+                owners_.resize(idx + 1);
+                values_.resize(owners_.size() * element_size_);
+            }
+
+            auto* res = values_.data() + idx * element_size_;
+
+            if (owners_[idx] != e)
+            {
+                owners_[idx] = e;
+                std::memset(res, 0, element_size_);
+            }
+
+            return res;
+        }
+
+        void erase(aecs::entity::id e) noexcept
+        {
+            const auto idx = e.index();
+
+            if (idx < owners_.size() && owners_[idx] == e)
+            {
+                owners_[idx] = aecs::entity::id{};
+            }
+        }
+    };
+
+private:
+    std::unordered_map<std::size_t, column> columns_;
+
+public:
+    delta_baseline() = default;
+
+    // the values of the component with hash, created if missing.
+    column& values(std::size_t hash, std::size_t element_size)
+    {
+        auto& res = columns_.try_emplace(hash, element_size).first->second;
+        assert(res.element_size() == element_size);
+        return res;
+    }
+
+    // the values of the component with hash, or nullptr.
+    const column* find(std::size_t hash) const
+    {
+        auto col = columns_.find(hash);
+        return col == columns_.end() ? nullptr : &col->second;
+    }
+
+    // the stored value of e for the component with hash, or nullptr.
+    const unsigned char* find(std::size_t hash, aecs::entity::id e) const
+    {
+        auto col = columns_.find(hash);
+        return col == columns_.end() ? nullptr : col->second.find(e);
+    }
+
+    // the stored value of e, which is inserted as all zero bytes if missing.
+    unsigned char*
+        get(std::size_t hash, std::size_t element_size, aecs::entity::id e)
+    {
+        return values(hash, element_size).get(e);
+    }
+
+    // drop the values of e, for example once it got destroyed.
+    void erase(aecs::entity::id e)
+    {
+        for (auto& col : columns_)
+        {
+            col.second.erase(e);
+        }
+    }
+
+    void clear() noexcept
+    {
+        columns_.clear();
+    }
+};
+
+namespace detail
+{
+namespace delta
+{
+struct record
+{
+    std::uint64_t hash;
+    std::uint32_t count;
+    std::uint32_t element_size;
+    // bytes of the run-length encoded values after the entities
+    std::uint64_t encoded_size;
+};
+
+// the largest element size accepted for a component neither the baseline
+// nor the receiving world knows, which bounds what a record can allocate
+constexpr std::size_t max_unknown_element_size = std::size_t{1} << 12;
+
+// bytes per element of col, 0 if it has no per element representation.
+inline std::size_t element_size(const aecs::polymorphic_container& col)
+{
+    const auto size = col.raw_size(1);
+    return col.raw_size(2) == 2 * size ? size : 0;
+}
+
+inline void write_varint(std::vector<unsigned char>& out, std::size_t n)
+{
+    while (n >= 0x80)
+    {
+        out.push_back(static_cast<unsigned char>(n | 0x80));
+        n >>= 7;
+    }
+
+    out.push_back(static_cast<unsigned char>(n));
+}
+
+inline bool read_varint(const unsigned char*& first,
+                        const unsigned char*  last,
+                        std::size_t&          n) noexcept
+{
+    n = 0;
+
+    for (unsigned shift = 0; first != last && shift < 64; shift += 7)
+    {
+        const auto byte = *first++;
+        n |= static_cast<std::size_t>(byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// encode bytes as pairs of (zero run length, literal length, literals).
+inline void encode_rle(std::vector<unsigned char>& out,
+                       const unsigned char*        bytes,
+                       std::size_t                 size)
+{
+    std::size_t i = 0;
+
+    while (i != size)
+    {
+        const auto zeros = i;
+
+        while (i != size && bytes[i] == 0)
+        {
+            ++i;
+        }
+
+        const auto literals = i;
+
+        // a single zero between literals is cheaper to keep as literal
+        while (i != size &&
+               (bytes[i] != 0 || (i + 1 != size && bytes[i + 1] != 0)))
+        {
+            ++i;
+        }
+
+        write_varint(out, literals - zeros);
+        write_varint(out, i - literals);
+        out.insert(out.end(), bytes + literals, bytes + i);
+    }
+}
+
+// decode exactly size bytes into out, returns false on malformed input.
+inline bool decode_rle(const unsigned char* first,
+                       const unsigned char* last,
+                       unsigned char*       out,
+                       std::size_t          size) noexcept
+{
+    std::size_t i = 0;
+
+    while (i != size)
+    {
+        std::size_t zeros, literals;
+
+        if (!read_varint(first, last, zeros) ||
+            !read_varint(first, last, literals) || zeros > size - i ||
+            literals > size - i - zeros ||
+            literals > static_cast<std::size_t>(last - first))
+        {
+            return false;
+        }
+
+        std::memset(out + i, 0, zeros);
+        i += zeros;
+        std::memcpy(out + i, first, literals);
+        i += literals;
+        first += literals;
+    }
+
+    return first == last;
+}
+
+template<typename T>
+void append_bytes(std::vector<unsigned char>& out, const T& value)
+{
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+} // namespace delta
+} // namespace detail
+
+// Append a delta of every value in chunks of w changed since the version
+// since to out, and update baseline to the encoded state. Returns the amount
+// of changed values.
+inline std::size_t encode_delta(const aecs::world&          w,
+                                std::uint64_t               since,
+                                aecs::delta_baseline&       baseline,
+                                std::vector<unsigned char>& out)
+{
+    namespace delta = detail::delta;
+
+    std::size_t res = 0;
+
+    auto rows    = std::vector<std::size_t>{};
+    auto values  = std::vector<unsigned char>{};
+    auto changed = std::vector<std::size_t>{};
+    auto xored   = std::vector<unsigned char>{};
+    auto encoded = std::vector<unsigned char>{};
+
+    for (std::size_t a = 0; a != w.archetype_count(); ++a)
+    {
+        const auto& arch = w.archetype(a);
+
+        for (std::size_t chunk = 0; chunk != arch.chunk_count(); ++chunk)
+        {
+            const auto first = chunk * aecs::archetype::chunk_rows;
+            const auto count =
+                std::min(aecs::archetype::chunk_rows, arch.size() - first);
+
+            rows.resize(count);
+            std::iota(rows.begin(), rows.end(), first);
+
+            for (std::size_t c = 0; c != arch.column_count(); ++c)
+            {
+                const auto& col  = arch.column(c);
+                const auto  size = delta::element_size(col);
+
+                if (size == 0 || !arch.changed_since(c, chunk, since))
+                {
+                    continue;
+                }
+
+                // the raw values of the whole chunk
+                values.resize(count * size);
+
+                if (col.element_size() == size)
+                {
+                    // straight from the storage, the runs overlapping the
+                    // chunk
+                    col.for_each_run([&](std::size_t run,
+                                         const void* data,
+                                         std::size_t n) {
+                        const auto lo = std::max(run, first);
+                        const auto hi = std::min(run + n, first + count);
+                        const auto* src =
+                            static_cast<const unsigned char*>(data);
+
+                        if (lo < hi)
+                        {
+                            std::memcpy(values.data() + (lo - first) * size,
+                                        src + (lo - run) * size,
+                                        (hi - lo) * size);
+                        }
+                    });
+                }
+                else
+                {
+                    // proxy containers, such as soa_container
+                    auto tmp = col.replicate();
+                    col.copy_rows_to(*tmp, rows.data(), count);
+                    tmp->copy_raw(values.data());
+                }
+
+                changed.clear();
+                xored.clear();
+
+                auto& base_col = baseline.values(col.component_hash(), size);
+
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    const auto  e     = arch.entities()[first + i];
+                    const auto* value = values.data() + i * size;
+                    auto*       base  = base_col.get(e);
+
+                    if (std::memcmp(base, value, size) == 0)
+                    {
+                        continue;
+                    }
+
+                    changed.push_back(i);
+
+                    for (std::size_t b = 0; b != size; ++b)
+                    {
+                        xored.push_back(base[b] ^ value[b]);
+                    }
+
+                    std::memcpy(base, value, size);
+                }
+
+                if (changed.empty())
+                {
+                    continue;
+                }
+
+                encoded.clear();
+                delta::encode_rle(encoded, xored.data(), xored.size());
+
+                delta::append_bytes(
+                    out,
+                    delta::record{col.component_hash(),
+                                  static_cast<std::uint32_t>(changed.size()),
+                                  static_cast<std::uint32_t>(size),
+                                  encoded.size()});
+
+                for (auto i : changed)
+                {
+                    delta::append_bytes(out, arch.entities()[first + i]);
+                }
+
+                out.insert(out.end(), encoded.begin(), encoded.end());
+                res += changed.size();
+            }
+        }
+    }
+
+    return res;
+}
+
+// Apply a delta produced by encode_delta to w and baseline. Values of dead
+// entities or of components their archetype doesn't have only update the
+// baseline. Written chunks are marked with the version of w. Returns false
+// if data is malformed, names an entity index w never handed out or gives a
+// component another element size than its baseline or a column of w has,
+// records before the malformed one are applied.
+inline bool apply_delta(aecs::world&          w,
+                        const void*           data,
+                        std::size_t           size,
+                        aecs::delta_baseline& baseline)
+{
+    namespace delta = detail::delta;
+
+    const auto* first = static_cast<const unsigned char*>(data);
+    const auto* last  = first + size;
+
+    auto ids    = std::vector<aecs::entity::id>{};
+    auto xored  = std::vector<unsigned char>{};
+    auto values = std::vector<unsigned char>{};
+    auto rows   = std::vector<std::size_t>{};
+
+    while (first != last)
+    {
+        auto rec = delta::record{};
+
+        if (static_cast<std::size_t>(last - first) < sizeof(rec))
+        {
+            return false;
+        }
+
+        std::memcpy(&rec, first, sizeof(rec));
+        first += sizeof(rec);
+
+        const auto id_bytes = std::size_t{rec.count} * sizeof(aecs::entity::id);
+
+        // encode_delta writes a record per chunk
+        if (rec.element_size == 0 || rec.count > aecs::archetype::chunk_rows ||
+            static_cast<std::size_t>(last - first) < id_bytes ||
+            static_cast<std::size_t>(last - first) - id_bytes <
+                rec.encoded_size)
+        {
+            return false;
+        }
+
+        ids.resize(rec.count);
+        std::memcpy(ids.data(), first, id_bytes);
+        first += id_bytes;
+
+        // the baseline is indexed by entity index, indices w never handed
+        // out can't come from a matching sender
+        for (auto e : ids)
+        {
+            if (e.index() >= w.entities().capacity())
+            {
+                return false;
+            }
+        }
+
+        // the values have to fit the baseline and every local column of the
+        // component, both are allocated from element_size
+        const auto* base_known = baseline.find(rec.hash);
+
+        if (base_known && base_known->element_size() != rec.element_size)
+        {
+            return false;
+        }
+
+        auto known = base_known != nullptr;
+        auto prev  = w.archetype_count();
+
+        for (auto e : ids)
+        {
+            if (!w.alive(e) || w.entities().locate(e).archetype == prev)
+            {
+                continue;
+            }
+
+            prev = w.entities().locate(e).archetype;
+
+            const auto& arch    = w.archetype(prev);
+            const auto  col_idx = arch.column_index(rec.hash);
+
+            if (col_idx != arch.column_count())
+            {
+                if (delta::element_size(arch.column(col_idx)) !=
+                    rec.element_size)
+                {
+                    return false;
+                }
+
+                known = true;
+            }
+        }
+
+        if (!known && rec.element_size > delta::max_unknown_element_size)
+        {
+            return false;
+        }
+
+        xored.resize(std::size_t{rec.count} * rec.element_size);
+
+        if (!delta::decode_rle(
+                first, first + rec.encoded_size, xored.data(), xored.size()))
+        {
+            return false;
+        }
+
+        first += rec.encoded_size;
+
+        auto& base_col = baseline.values(rec.hash, rec.element_size);
+
+        // the new values are the baseline xor the delta
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            auto* base  = base_col.get(ids[i]);
+            auto* value = xored.data() + i * rec.element_size;
+
+            for (std::size_t b = 0; b != rec.element_size; ++b)
+            {
+                value[b] ^= base[b];
+            }
+
+            std::memcpy(base, value, rec.element_size);
+        }
+
+        // entities of a record usually share their archetype, write every
+        // archetype's values with one append_raw and a batch of assign_from
+        for (std::size_t i = 0; i != ids.size();)
+        {
+            if (!w.alive(ids[i]))
+            {
+                ++i;
+                continue;
+            }
+
+            const auto arch_idx = w.entities().locate(ids[i]).archetype;
+            auto&      arch     = w.archetype(arch_idx);
+            const auto col_idx  = arch.column_index(rec.hash);
+            const auto group    = i;
+
+            rows.clear();
+            values.clear();
+
+            for (; i != ids.size() && w.alive(ids[i]) &&
+                   w.entities().locate(ids[i]).archetype == arch_idx;
+                 ++i)
+            {
+                const auto* value = xored.data() + i * rec.element_size;
+                rows.push_back(w.entities().locate(ids[i]).row);
+                values.insert(values.end(), value, value + rec.element_size);
+            }
+
+            if (col_idx == arch.column_count())
+            {
+                continue;
+            }
+
+            auto&      col   = arch.column(col_idx);
+            auto       tmp   = col.replicate();
+            const auto chunk = aecs::archetype::chunk_rows;
+            tmp->append_raw(values.data(), i - group);
+
+            for (std::size_t r = 0; r != rows.size(); ++r)
+            {
+                col.assign_from(rows[r], *tmp, r);
+                arch.mark_changed(col_idx, rows[r] / chunk, w.version());
+            }
+        }
+    }
+
+    return true;
+}
+} // namespace aecs
\ No newline at end of file
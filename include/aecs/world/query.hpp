@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "aecs/component/mask.hpp"
+#include "aecs/entity/constraint.hpp"
+#include "aecs/utility/thread_pool.hpp"
+#include "aecs/utility/trace.hpp"
+#include "aecs/world/view.hpp"
+#include "aecs/world/world.hpp"
+
+namespace aecs
+{
+// A persistent view. The indices of the matching archetypes are cached and
+// since a world only ever appends archetypes, refreshing the cache only has
+// to match the archetypes created since the last refresh.
+//
+// Iteration refreshes automatically, once the set of archetypes has settled
+// this amounts to a single comparison. Like view, iterating marks the chunks
+// with write access as changed.
+class query
+{
+private:
+    aecs::world*                          world_;
+    std::vector<aecs::entity::constraint> constraints_;
+    std::optional<aecs::access_mask<>>    mask_;
+    std::vector<std::size_t>              writes_;
+    std::vector<std::uint32_t>            matches_;
+    // archetypes [0, seen_) were matched already
+    std::size_t seen_{0};
+    // size of the component registry when mask_ was computed
+    std::size_t known_{0};
+
+public:
+    template<std::size_t N>
+    query(aecs::world& w, const aecs::entity::constraint_list<N>& cs)
+        : query{w, aecs::entity::constraint_view{cs}}
+    {}
+
+    query(aecs::world& w, aecs::entity::constraint_view cs)
+        : world_{&w},
+          constraints_{cs.begin(), cs.end()},
+          mask_{w.components().find_access_mask(cs)},
+          writes_{detail::write_hashes(cs)},
+          known_{w.components().size()}
+    {
+        refresh();
+    }
+
+    // nullopt if a required component is unknown to the world, no archetype
+    // matches then.
+    const std::optional<aecs::access_mask<>>& mask() const noexcept
+    {
+        return mask_;
+    }
+
+    // match the archetypes created since the last refresh.
+    void refresh()
+    {
+        const auto& components = world_->components();
+        const auto  count      = world_->archetype_count();
+
+        // components registered since only appear in archetypes which
+        // weren't seen yet, earlier matches stay valid.
+        if (known_ != components.size())
+        {
+            const auto cs = aecs::entity::constraint_view{
+                constraints_.data(), constraints_.data() + constraints_.size()};
+
+            mask_  = components.find_access_mask(cs);
+            known_ = components.size();
+        }
+
+        for (; seen_ != count; ++seen_)
+        {
+            if (mask_ && mask_->matches(world_->archetype_mask(seen_)))
+            {
+                matches_.push_back(static_cast<std::uint32_t>(seen_));
+            }
+        }
+    }
+
+    // indices of all matching archetypes, empty ones included.
+    const std::vector<std::uint32_t>& archetypes()
+    {
+        refresh();
+        return matches_;
+    }
+
+    // amount of matching rows
+    std::size_t size()
+    {
+        std::size_t res = 0;
+
+        for (auto idx : archetypes())
+        {
+            res += world_->archetype(idx).size();
+        }
+
+        return res;
+    }
+
+    std::vector<chunk> chunks()
+    {
+        auto res = std::vector<chunk>{};
+
+        for (auto idx : archetypes())
+        {
+            detail::append_chunks(res, world_->archetype(idx));
+        }
+
+        return res;
+    }
+
+    // the chunks whose column hash changed after version since.
+    std::vector<chunk> changed_chunks(std::size_t hash, std::uint64_t since)
+    {
+        auto res = chunks();
+        res.erase(std::remove_if(res.begin(),
+                                 res.end(),
+                                 [&](const chunk& c) {
+                                     return !c.changed_since(hash, since);
+                                 }),
+                  res.end());
+        return res;
+    }
+
+    template<typename T>
+    std::vector<chunk> changed_chunks(std::uint64_t since)
+    {
+        return changed_chunks(aecs::component_type<T>::hash(), since);
+    }
+
+    // call fn(chunk) for every chunk on the calling thread.
+    template<typename F>
+    void for_each(F&& fn)
+    {
+        for_each_impl(chunks(), fn);
+    }
+
+    // call fn(chunk) only for chunks where T changed after version since,
+    // unchanged chunks are skipped entirely.
+    template<typename T, typename F>
+    void for_each_changed(std::uint64_t since, F&& fn)
+    {
+        for_each_impl(changed_chunks<T>(since), fn);
+    }
+
+    // call fn(chunk) for every chunk, distributed over the pool. fn is called
+    // concurrently and must not make structural changes to the world.
+    template<typename F>
+    void parallel_for_each(aecs::thread_pool& pool, F&& fn)
+    {
+        const auto cs      = chunks();
+        const auto version = world_->version();
+
+        pool.parallel_for(cs.size(), [&](std::size_t i) {
+            AECS_TRACE_SCOPE("chunk job", static_cast<std::int64_t>(i));
+            detail::mark_writes(cs[i], writes_, version);
+            fn(cs[i]);
+        });
+    }
+
+private:
+    template<typename F>
+    void for_each_impl(const std::vector<chunk>& cs, F& fn)
+    {
+        const auto version = world_->version();
+
+        for (const auto& c : cs)
+        {
+            detail::mark_writes(c, writes_, version);
+            fn(c);
+        }
+    }
+};
+} // namespace aecs
\ No newline at end of file
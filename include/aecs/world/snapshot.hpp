@@ -0,0 +1,490 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "aecs/component/set.hpp"
+#include "aecs/container/archetype.hpp"
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/wrapped.hpp"
+#include "aecs/entity/id.hpp"
+#include "aecs/entity/registry.hpp"
+#include "aecs/world/world.hpp"
+
+// Binary snapshots of a world.
+//
+// A snapshot stores the entity slots followed by every archetype, each as its
+// entity ids and one section per column keyed by the component hash and name.
+// Column data is the raw representation of polymorphic_container::copy_raw,
+// aligned to snapshot_alignment. Snapshots are only readable on machines with
+// the same byte order and type layouts as the writer.
+//
+// load_snapshot maps the file and fills every column with a single
+// append_raw straight from the mapped pages, so loading never looks at
+// individual elements.
+namespace aecs
+{
+inline constexpr std::size_t snapshot_alignment = 64;
+
+namespace detail
+{
+namespace snapshot
+{
+constexpr char          magic[8] = {'A', 'E', 'C', 'S', 'S', 'N', 'P', 0};
+constexpr std::uint32_t format_version = 1;
+constexpr std::uint32_t byte_order     = 0x01020304;
+
+struct header
+{
+    char          magic[8];
+    std::uint32_t format;
+    std::uint32_t byte_order;
+    std::uint64_t version;
+    std::uint64_t slot_count;
+    std::uint32_t free_head;
+    std::uint32_t archetype_count;
+};
+
+struct archetype_record
+{
+    std::uint64_t rows;
+    std::uint64_t columns;
+};
+
+// followed by the name, then the data at the next snapshot_alignment
+struct column_record
+{
+    std::uint64_t hash;
+    std::uint64_t bytes;
+    std::uint64_t name_size;
+};
+
+// written as is, so their layout is part of the format
+static_assert(sizeof(aecs::entity::registry::slot) == 12);
+static_assert(sizeof(aecs::entity::id) == 8);
+static_assert(std::is_trivially_copyable_v<aecs::entity::registry::slot>);
+static_assert(std::is_trivially_copyable_v<aecs::entity::id>);
+
+class writer
+{
+private:
+    std::ostream* os_;
+    std::size_t   pos_{};
+
+public:
+    explicit writer(std::ostream& os) noexcept : os_{&os}
+    {}
+
+    void write(const void* data, std::size_t size)
+    {
+        os_->write(static_cast<const char*>(data),
+                   static_cast<std::streamsize>(size));
+        pos_ += size;
+    }
+
+    template<typename T>
+    void write(const T& value)
+    {
+        write(std::addressof(value), sizeof(T));
+    }
+
+    void pad(std::size_t alignment)
+    {
+        static constexpr char zeros[snapshot_alignment] = {};
+        write(zeros, (alignment - pos_ % alignment) % alignment);
+    }
+};
+
+// bounds checked reading of the mapped file
+class reader
+{
+private:
+    const unsigned char* first_;
+    std::size_t          size_;
+    std::size_t          pos_{};
+
+public:
+    reader(const void* data, std::size_t size) noexcept
+        : first_{static_cast<const unsigned char*>(data)}, size_{size}
+    {}
+
+    // a pointer to the next size bytes, or nullptr if the file is too short.
+    const void* take(std::size_t size) noexcept
+    {
+        if (size > size_ - pos_)
+        {
+            return nullptr;
+        }
+
+        const auto* res = first_ + pos_;
+        pos_ += size;
+        return res;
+    }
+
+    template<typename T>
+    const T* take(std::size_t count = 1) noexcept
+    {
+        if (count > (size_ - pos_) / sizeof(T))
+        {
+            return nullptr;
+        }
+
+        return static_cast<const T*>(take(count * sizeof(T)));
+    }
+
+    bool skip_to(std::size_t alignment) noexcept
+    {
+        return take((alignment - pos_ % alignment) % alignment) != nullptr;
+    }
+};
+
+// a read only private mapping of a whole file
+class mapping
+{
+private:
+    void*       data_{MAP_FAILED};
+    std::size_t size_{};
+
+public:
+    explicit mapping(const char* path) noexcept
+    {
+        const auto fd = ::open(path, O_RDONLY);
+
+        if (fd == -1)
+        {
+            return;
+        }
+
+        struct ::stat st;
+
+        if (::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            size_ = static_cast<std::size_t>(st.st_size);
+            data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if (data_ != MAP_FAILED)
+            {
+                // columns are copied out front to back
+                ::madvise(data_, size_, MADV_SEQUENTIAL);
+            }
+        }
+
+        ::close(fd);
+    }
+
+    mapping(const mapping&) = delete;
+    mapping& operator=(const mapping&) = delete;
+
+    ~mapping()
+    {
+        if (data_ != MAP_FAILED)
+        {
+            ::munmap(data_, size_);
+        }
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return data_ != MAP_FAILED;
+    }
+
+    const void* data() const noexcept
+    {
+        return data_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+};
+
+template<typename T>
+std::unique_ptr<aecs::polymorphic_container> make_column()
+{
+    return std::make_unique<aecs::wrapped_container<T>>();
+}
+
+// every row of archetypes has to be located by the slot of its entity, and
+// the free list starting at free_head has to link every dead slot once.
+inline bool consistent(const std::vector<aecs::archetype>& archetypes,
+                       const std::vector<entity::registry::slot>& slots,
+                       std::uint32_t free_head)
+{
+    std::size_t alive = 0;
+    std::size_t dead  = 0;
+
+    for (const auto& s : slots)
+    {
+        const auto loc = s.location;
+
+        if (loc.archetype == entity::registry::dead)
+        {
+            ++dead;
+            continue;
+        }
+
+        if (loc.archetype >= archetypes.size() ||
+            loc.row >= archetypes[loc.archetype].size())
+        {
+            return false;
+        }
+
+        const auto e = archetypes[loc.archetype].entities()[loc.row];
+
+        if (e.index() != static_cast<std::size_t>(&s - slots.data()) ||
+            e.generation() != s.generation)
+        {
+            return false;
+        }
+
+        ++alive;
+    }
+
+    std::size_t rows = 0;
+
+    for (const auto& arch : archetypes)
+    {
+        rows += arch.size();
+    }
+
+    if (alive != rows)
+    {
+        return false;
+    }
+
+    // a link to an alive slot or a cycle makes the list longer than dead
+    std::size_t linked = 0;
+    auto        idx    = free_head;
+
+    while (idx != entity::registry::dead)
+    {
+        if (idx >= slots.size() ||
+            slots[idx].location.archetype != entity::registry::dead ||
+            ++linked > dead)
+        {
+            return false;
+        }
+
+        idx = slots[idx].location.row;
+    }
+
+    return linked == dead;
+}
+} // namespace snapshot
+} // namespace detail
+
+// write every entity and component of w to os, returns false if writing
+// failed.
+inline bool write_snapshot(const aecs::world& w, std::ostream& os)
+{
+    namespace snap = detail::snapshot;
+
+    const auto& entities = w.entities();
+    auto        out      = snap::writer{os};
+
+    auto head = snap::header{};
+    std::memcpy(head.magic, snap::magic, sizeof(head.magic));
+    head.format          = snap::format_version;
+    head.byte_order      = snap::byte_order;
+    head.version         = w.version();
+    head.slot_count      = entities.capacity();
+    head.free_head       = entities.free_head();
+    head.archetype_count = static_cast<std::uint32_t>(w.archetype_count());
+
+    out.write(head);
+    out.write(entities.slots(),
+              entities.capacity() * sizeof(aecs::entity::registry::slot));
+
+    auto buffer = std::vector<unsigned char>{};
+
+    for (std::size_t a = 0; a != w.archetype_count(); ++a)
+    {
+        const auto& arch = w.archetype(a);
+
+        out.pad(alignof(std::uint64_t));
+        out.write(snap::archetype_record{arch.size(), arch.column_count()});
+        out.write(arch.entities().data(),
+                  arch.size() * sizeof(aecs::entity::id));
+
+        for (std::size_t c = 0; c != arch.column_count(); ++c)
+        {
+            const auto& col  = arch.column(c);
+            const auto  name = col.component_name();
+            const auto  size = col.raw_size(arch.size());
+
+            out.pad(alignof(std::uint64_t));
+            out.write(snap::column_record{col.component_hash(), size,
+                                          name.size()});
+            out.write(name.data(), name.size());
+            out.pad(snapshot_alignment);
+
+            buffer.resize(size);
+            col.copy_raw(buffer.data());
+            out.write(buffer.data(), size);
+        }
+    }
+
+    return static_cast<bool>(os);
+}
+
+inline bool write_snapshot(const aecs::world& w, const char* path)
+{
+    auto file = std::ofstream{path, std::ios::binary};
+    return file && write_snapshot(w, file);
+}
+
+// Load the snapshot at path into w, which must be empty. Every component in
+// the snapshot must be one of Ts. Returns false and leaves w untouched if the
+// file can't be mapped, is malformed or contains other components.
+template<typename... Ts>
+bool load_snapshot(aecs::world& w, const char* path)
+{
+    namespace snap = detail::snapshot;
+
+    using set            = aecs::component_set<Ts...>;
+    using make_column_fn = std::unique_ptr<aecs::polymorphic_container> (*)();
+
+    static constexpr auto factories = std::array<make_column_fn, set::size>{
+        &snap::make_column<Ts>...};
+
+    const auto file = snap::mapping{path};
+
+    if (!file)
+    {
+        return false;
+    }
+
+    auto        in   = snap::reader{file.data(), file.size()};
+    const auto* head = in.template take<snap::header>();
+
+    if (!head ||
+        std::memcmp(head->magic, snap::magic, sizeof(snap::magic)) != 0 ||
+        head->format != snap::format_version ||
+        head->byte_order != snap::byte_order || head->version == 0 ||
+        head->archetype_count == 0)
+    {
+        return false;
+    }
+
+    using slot       = aecs::entity::registry::slot;
+    const auto* data = head->slot_count <= aecs::entity::registry::dead
+                           ? in.template take<slot>(head->slot_count)
+                           : nullptr;
+
+    if (!data)
+    {
+        return false;
+    }
+
+    auto slots = std::vector<slot>(head->slot_count);
+    std::memcpy(slots.data(), data, slots.size() * sizeof(slot));
+
+    auto archetypes = std::vector<aecs::archetype>{};
+    archetypes.reserve(head->archetype_count);
+
+    auto columns = std::vector<std::unique_ptr<aecs::polymorphic_container>>{};
+    auto sources = std::vector<const void*>{};
+    // every archetype has a unique signature
+    auto signatures = std::set<std::vector<std::size_t>>{};
+
+    for (std::uint32_t a = 0; a != head->archetype_count; ++a)
+    {
+        if (!in.skip_to(alignof(std::uint64_t)))
+        {
+            return false;
+        }
+
+        const auto* rec = in.template take<snap::archetype_record>();
+
+        if (!rec)
+        {
+            return false;
+        }
+
+        const auto* ids = in.template take<aecs::entity::id>(rec->rows);
+
+        if (!ids || (a == 0) != (rec->columns == 0))
+        {
+            return false;
+        }
+
+        columns.clear();
+        sources.clear();
+
+        for (std::uint64_t c = 0; c != rec->columns; ++c)
+        {
+            const auto* col = in.skip_to(alignof(std::uint64_t))
+                                  ? in.template take<snap::column_record>()
+                                  : nullptr;
+
+            if (!col)
+            {
+                return false;
+            }
+
+            const auto* name = in.template take<char>(col->name_size);
+            const auto  idx  = set::index(col->hash);
+
+            // columns are written sorted by hash
+            if (!name || idx == set::npos ||
+                (!columns.empty() &&
+                 columns.back()->component_hash() >= col->hash))
+            {
+                return false;
+            }
+
+            columns.push_back(factories[idx]());
+
+            if (columns.back()->component_name() !=
+                    std::string_view{name, col->name_size} ||
+                columns.back()->raw_size(rec->rows) != col->bytes ||
+                !in.skip_to(snapshot_alignment))
+            {
+                return false;
+            }
+
+            sources.push_back(in.take(col->bytes));
+
+            if (!sources.back())
+            {
+                return false;
+            }
+        }
+
+        archetypes.emplace_back(std::move(columns));
+
+        if (!signatures.insert(archetypes.back().hashes()).second)
+        {
+            return false;
+        }
+
+        archetypes.back().append_raw(sources.data(), ids, rec->rows);
+    }
+
+    if (!snap::consistent(archetypes, slots, head->free_head))
+    {
+        return false;
+    }
+
+    w.restore(std::move(archetypes),
+              aecs::entity::registry{std::move(slots), head->free_head},
+              head->version);
+    return true;
+}
+} // namespace aecs
\ No newline at end of file
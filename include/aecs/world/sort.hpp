@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "aecs/component/type.hpp"
+#include "aecs/container/archetype.hpp"
+#include "aecs/utility/radix_sort.hpp"
+#include "aecs/utility/thread_pool.hpp"
+#include "aecs/world/world.hpp"
+
+// Reordering the rows of archetypes by a key computed from one of their
+// components, for example the morton code of a position, so entities which
+// are close by key are close in memory as well.
+//
+// Every archetype storing T is sorted on its own, all of its columns and the
+// entity locations follow the same permutation. Archetypes which are already
+// in order are left untouched, reordered archetypes have every row marked
+// with the current version of the world.
+namespace aecs
+{
+namespace detail
+{
+namespace sort
+{
+// key(value) of every row of the column of T, spread over pool if any.
+template<typename T, typename F>
+void compute_keys(const aecs::archetype&      arch,
+                  F&                          key,
+                  std::vector<std::uint64_t>& keys,
+                  aecs::thread_pool*          pool)
+{
+    using key_type = std::decay_t<std::invoke_result_t<F&, const T&>>;
+
+    static_assert(std::is_unsigned_v<key_type> &&
+                      sizeof(key_type) <= sizeof(std::uint64_t),
+                  "key has to return an unsigned integer of at most 64 bits");
+
+    const auto& col   = arch.template get<T>();
+    const auto  rows  = aecs::archetype::chunk_rows;
+    const auto  count = arch.chunk_count();
+
+    keys.resize(arch.size());
+
+    auto chunk = [&](std::size_t c) {
+        const auto last = std::min(arch.size(), (c + 1) * rows);
+
+        for (auto i = c * rows; i != last; ++i)
+        {
+            if constexpr (std::is_lvalue_reference_v<decltype(col[i])>)
+            {
+                keys[i] = key(col[i]);
+            }
+            else
+            {
+                // proxy containers such as soa_container
+                keys[i] = key(static_cast<T>(col[i]));
+            }
+        }
+    };
+
+    if (pool)
+    {
+        pool->parallel_for(count, chunk);
+    }
+    else
+    {
+        for (std::size_t c = 0; c != count; ++c)
+        {
+            chunk(c);
+        }
+    }
+}
+
+template<typename T, typename F>
+void sort_rows(aecs::world&       w,
+               F&                 key,
+               aecs::sort_mode    mode,
+               aecs::thread_pool* pool)
+{
+    const auto hash = aecs::component_type<T>::hash();
+
+    auto keys  = std::vector<std::uint64_t>{};
+    auto order = std::vector<std::size_t>{};
+
+    for (std::size_t a = 0; a != w.archetype_count(); ++a)
+    {
+        const auto& arch = w.archetype(a);
+
+        if (arch.size() < 2 || !arch.has_component(hash))
+        {
+            continue;
+        }
+
+        compute_keys<T>(arch, key, keys, pool);
+
+        if (pool)
+        {
+            aecs::sort_order(*pool, keys.data(), keys.size(), order, mode);
+        }
+        else
+        {
+            aecs::sort_order(keys.data(), keys.size(), order, mode);
+        }
+
+        std::size_t i = 0;
+
+        while (i != order.size() && order[i] == i)
+        {
+            ++i;
+        }
+
+        if (i != order.size())
+        {
+            w.permute_rows(a, order.data());
+        }
+    }
+}
+} // namespace sort
+} // namespace detail
+
+// sort the rows of every archetype storing T by key(const T&), which returns
+// an unsigned integer of at most 64 bits. Rows with equal keys keep their
+// order.
+template<typename T, typename F>
+void sort_rows(aecs::world&    w,
+               F&&             key,
+               aecs::sort_mode mode = aecs::sort_mode::full)
+{
+    detail::sort::sort_rows<T>(w, key, mode, nullptr);
+}
+
+// the same, with keys computed and sorted in parallel on pool. key is called
+// concurrently.
+template<typename T, typename F>
+void sort_rows(aecs::world&       w,
+               aecs::thread_pool& pool,
+               F&&                key,
+               aecs::sort_mode    mode = aecs::sort_mode::full)
+{
+    detail::sort::sort_rows<T>(w, key, mode, &pool);
+}
+} // namespace aecs
\ No newline at end of file
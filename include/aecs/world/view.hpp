@@ -0,0 +1,233 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "aecs/component/mask.hpp"
+#include "aecs/container/archetype.hpp"
+#include "aecs/entity/constraint.hpp"
+#include "aecs/utility/thread_pool.hpp"
+#include "aecs/utility/trace.hpp"
+#include "aecs/world/world.hpp"
+
+namespace aecs
+{
+// A contiguous range of rows [begin, end) within a single archetype.
+class chunk
+{
+private:
+    aecs::archetype* table_;
+    std::size_t      begin_;
+    std::size_t      end_;
+
+public:
+    constexpr chunk(aecs::archetype& table,
+                    std::size_t      begin,
+                    std::size_t      end) noexcept
+        : table_{&table}, begin_{begin}, end_{end}
+    {}
+
+    constexpr std::size_t begin() const noexcept
+    {
+        return begin_;
+    }
+
+    constexpr std::size_t end() const noexcept
+    {
+        return end_;
+    }
+
+    constexpr std::size_t size() const noexcept
+    {
+        return end_ - begin_;
+    }
+
+    aecs::archetype& table() const noexcept
+    {
+        return *table_;
+    }
+
+    // the full column of T, only rows in [begin(), end()) belong to the chunk.
+    template<typename T>
+    decltype(auto) get() const noexcept
+    {
+        return table_->template get<T>();
+    }
+
+    aecs::entity::id entity(std::size_t row) const noexcept
+    {
+        assert(row >= begin_ && row < end_);
+        return table_->entities()[row];
+    }
+
+    // index of the chunk within the archetype, for the change versions.
+    std::size_t index() const noexcept
+    {
+        return begin_ / aecs::archetype::chunk_rows;
+    }
+
+    bool changed_since(std::size_t hash, std::uint64_t since) const noexcept
+    {
+        const auto col = table_->column_index(hash);
+        assert(col != table_->column_count() &&
+               "component is not part of this archetype");
+        return table_->changed_since(col, index(), since);
+    }
+
+    // true if column T of this chunk was written after version since.
+    template<typename T>
+    bool changed_since(std::uint64_t since) const noexcept
+    {
+        return changed_since(aecs::component_type<T>::hash(), since);
+    }
+
+    void mark_changed(std::size_t hash, std::uint64_t version) const noexcept
+    {
+        const auto col = table_->column_index(hash);
+        assert(col != table_->column_count() &&
+               "component is not part of this archetype");
+        table_->mark_changed(col, index(), version);
+    }
+};
+
+namespace detail
+{
+// split the rows of arch into chunks of at most archetype::chunk_rows.
+inline void append_chunks(std::vector<chunk>& out, aecs::archetype& arch)
+{
+    for (std::size_t first = 0; first < arch.size();
+         first += aecs::archetype::chunk_rows)
+    {
+        out.emplace_back(
+            arch,
+            first,
+            std::min(first + aecs::archetype::chunk_rows, arch.size()));
+    }
+}
+
+// the hashes of all components with write access
+inline std::vector<std::size_t>
+    write_hashes(aecs::entity::constraint_view cs)
+{
+    auto res = std::vector<std::size_t>{};
+
+    for (const auto& c : cs)
+    {
+        if (c.access() == aecs::entity::access::write)
+        {
+            res.push_back(c.hash());
+        }
+    }
+
+    return res;
+}
+
+inline void mark_writes(const chunk&                    c,
+                        const std::vector<std::size_t>& writes,
+                        std::uint64_t                   version) noexcept
+{
+    for (auto h : writes)
+    {
+        c.mark_changed(h, version);
+    }
+}
+} // namespace detail
+
+// Iterates the rows of every archetype matching a constraint_list. Read and
+// write constraints are required components, exclude constraints reject
+// archetypes containing that component.
+//
+// Rows are handed out in chunks of at most archetype::chunk_rows rows, a
+// multiple of 64. Columns aligned to a cache line (aligned_container,
+// chunked_container) therefore never share a line between two chunks and
+// chunks can be written to from different threads without false sharing.
+//
+// for_each and parallel_for_each mark the columns with write access of every
+// chunk they hand out with the current world::version.
+class view
+{
+private:
+    aecs::world*                       world_;
+    std::optional<aecs::access_mask<>> mask_;
+    std::vector<std::size_t>           writes_;
+
+public:
+    template<std::size_t N>
+    view(aecs::world& w, const aecs::entity::constraint_list<N>& cs)
+        : view{w, aecs::entity::constraint_view{cs}}
+    {}
+
+    // only reads the component registry of w, so views can be created by
+    // systems running concurrently.
+    view(aecs::world& w, aecs::entity::constraint_view cs)
+        : world_{&w},
+          mask_{w.components().find_access_mask(cs)},
+          writes_{detail::write_hashes(cs)}
+    {}
+
+    // nullopt if a required component is unknown to the world, no archetype
+    // matches then.
+    const std::optional<aecs::access_mask<>>& mask() const noexcept
+    {
+        return mask_;
+    }
+
+    // true if the rows of archetype idx are iterated.
+    bool matches(std::size_t idx) const noexcept
+    {
+        return mask_ && mask_->matches(world_->archetype_mask(idx));
+    }
+
+    // every chunk of every matching archetype
+    std::vector<chunk> chunks() const
+    {
+        auto res = std::vector<chunk>{};
+
+        for (std::size_t i = 0; i != world_->archetype_count(); ++i)
+        {
+            auto& arch = world_->archetype(i);
+
+            if (arch.empty() || !matches(i))
+            {
+                continue;
+            }
+
+            detail::append_chunks(res, arch);
+        }
+
+        return res;
+    }
+
+    // call fn(chunk) for every chunk on the calling thread.
+    template<typename F>
+    void for_each(F&& fn) const
+    {
+        const auto version = world_->version();
+
+        for (const auto& c : chunks())
+        {
+            detail::mark_writes(c, writes_, version);
+            fn(c);
+        }
+    }
+
+    // call fn(chunk) for every chunk, distributed over the pool. fn is called
+    // concurrently and must not make structural changes to the world.
+    template<typename F>
+    void parallel_for_each(aecs::thread_pool& pool, F&& fn) const
+    {
+        const auto cs      = chunks();
+        const auto version = world_->version();
+
+        pool.parallel_for(cs.size(), [&](std::size_t i) {
+            AECS_TRACE_SCOPE("chunk job", static_cast<std::int64_t>(i));
+            detail::mark_writes(cs[i], writes_, version);
+            fn(cs[i]);
+        });
+    }
+};
+} // namespace aecs
\ No newline at end of file
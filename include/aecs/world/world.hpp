@@ -0,0 +1,639 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "aecs/component/mask.hpp"
+#include "aecs/component/registry.hpp"
+#include "aecs/component/type.hpp"
+#include "aecs/container/archetype.hpp"
+#include "aecs/container/polymorphic.hpp"
+#include "aecs/container/wrapped.hpp"
+#include "aecs/entity/id.hpp"
+#include "aecs/entity/registry.hpp"
+
+namespace aecs
+{
+// Owns all entities and the archetypes storing their components.
+//
+// Archetypes are only ever added, never removed, so an archetype index stays
+// valid for the lifetime of the world. Index 0 is the archetype without any
+// components.
+//
+// Every component hash is stored in a single container implementation, a
+// dynamic_container with the hash of a native component is rejected and vice
+// versa.
+//
+// The world keeps a change version. Every write through the world, and every
+// chunk handed to a writer by a view or query, marks the touched chunks of
+// the archetype with the current version.
+class world
+{
+private:
+    // how the columns of a component hash are stored
+    struct column_type
+    {
+        std::type_index type;
+        std::size_t     size;
+        std::size_t     alignment;
+
+        explicit column_type(const aecs::polymorphic_container& col)
+            : type{typeid(col)},
+              size{col.element_size()},
+              alignment{col.element_alignment()}
+        {}
+
+        bool operator==(const column_type& other) const noexcept
+        {
+            return type == other.type && size == other.size &&
+                   alignment == other.alignment;
+        }
+    };
+
+    struct archetype_node
+    {
+        std::unique_ptr<aecs::archetype> table;
+        // the dense indices of the stored components
+        aecs::component_mask<> mask;
+        // cached transitions when adding/removing a component hash
+        std::unordered_map<std::size_t, std::uint32_t> add_edges;
+        std::unordered_map<std::size_t, std::uint32_t> remove_edges;
+    };
+
+    aecs::entity::registry                            entities_;
+    aecs::component_registry                          components_;
+    std::vector<archetype_node>                       archetypes_;
+    std::map<std::vector<std::size_t>, std::uint32_t> archetype_lookup_;
+    // the container implementation of every stored component hash
+    std::unordered_map<std::size_t, column_type>      column_types_;
+    std::uint64_t                                     version_{1};
+
+public:
+    world()
+    {
+        insert_archetype(aecs::archetype{});
+    }
+
+    world(const world&) = delete;
+    world& operator=(const world&) = delete;
+
+    // amount of alive entities
+    std::size_t size() const noexcept
+    {
+        return entities_.size();
+    }
+
+    const aecs::entity::registry& entities() const noexcept
+    {
+        return entities_;
+    }
+
+    // the version writes are currently marked with, never 0.
+    std::uint64_t version() const noexcept
+    {
+        return version_;
+    }
+
+    // start a new version and return the previous one. A reader remembers
+    // the returned version and later asks for chunks changed since then,
+    // every write after this call is newer. Must not be called while systems
+    // are writing concurrently.
+    std::uint64_t advance_version() noexcept
+    {
+        return version_++;
+    }
+
+    // the dense component indices used by archetype masks
+    aecs::component_registry& components() noexcept
+    {
+        return components_;
+    }
+
+    const aecs::component_registry& components() const noexcept
+    {
+        return components_;
+    }
+
+    std::size_t archetype_count() const noexcept
+    {
+        return archetypes_.size();
+    }
+
+    aecs::archetype& archetype(std::size_t idx) noexcept
+    {
+        assert(idx < archetype_count());
+        return *archetypes_[idx].table;
+    }
+
+    const aecs::archetype& archetype(std::size_t idx) const noexcept
+    {
+        assert(idx < archetype_count());
+        return *archetypes_[idx].table;
+    }
+
+    // the components of archetype idx as a mask over components().
+    const aecs::component_mask<>& archetype_mask(std::size_t idx) const
+        noexcept
+    {
+        assert(idx < archetype_count());
+        return archetypes_[idx].mask;
+    }
+
+    // Replace the content of this world, which must be empty, used to load
+    // snapshots. archetypes[i] becomes archetype i and must have unique
+    // signatures, the first one without any components. entities has to
+    // locate every row of archetypes. All rows are marked with version.
+    void restore(std::vector<aecs::archetype> archetypes,
+                 aecs::entity::registry       entities,
+                 std::uint64_t                version)
+    {
+        assert(size() == 0 && archetype_count() == 1 &&
+               "only an empty world can be restored");
+        assert(!archetypes.empty() && archetypes.front().hashes().empty());
+        assert(version != 0);
+
+        archetypes_.clear();
+        archetype_lookup_.clear();
+        column_types_.clear();
+        entities_ = std::move(entities);
+        version_  = version;
+
+        for (auto& arch : archetypes)
+        {
+            arch.mark_rows_changed(0, arch.size(), version_);
+            insert_archetype(std::move(arch));
+        }
+    }
+
+    // create an entity with the passed components.
+    template<typename... Ts>
+    aecs::entity::id create(Ts&&... components)
+    {
+        const auto arch_idx =
+            archetype_index<std::remove_cv_t<std::remove_reference_t<Ts>>...>();
+        auto& arch = archetype(arch_idx);
+
+        const auto e = entities_.create(aecs::entity::location{
+            arch_idx, static_cast<std::uint32_t>(arch.size())});
+        const auto row = arch.push_back(e, std::forward<Ts>(components)...);
+        arch.mark_row_changed(row, version_);
+        return e;
+    }
+
+    void destroy(aecs::entity::id e)
+    {
+        const auto loc = entities_.locate(e);
+        remove_row(loc);
+        entities_.destroy(e);
+    }
+
+    bool alive(aecs::entity::id e) const noexcept
+    {
+        return entities_.alive(e);
+    }
+
+    template<typename T>
+    bool has(aecs::entity::id e) const noexcept
+    {
+        return archetype(entities_.locate(e).archetype)
+            .template has_component<T>();
+    }
+
+    // mutable access counts as a write to the chunk of e.
+    template<typename T>
+    decltype(auto) get(aecs::entity::id e) noexcept
+    {
+        const auto loc = entities_.locate(e);
+        mark_changed<T>(loc);
+        return archetype(loc.archetype).template get<T>()[loc.row];
+    }
+
+    template<typename T>
+    decltype(auto) get(aecs::entity::id e) const noexcept
+    {
+        const auto loc = entities_.locate(e);
+        return archetype(loc.archetype).template get<T>()[loc.row];
+    }
+
+    // add T to e, if e already has a T it is overwritten instead.
+    template<typename T, typename... Args>
+    void add(aecs::entity::id e, Args&&... args)
+    {
+        auto loc = entities_.locate(e);
+
+        if (!archetype(loc.archetype).template has_component<T>())
+        {
+            const auto target = add_transition(
+                loc.archetype, aecs::component_type<T>::hash(), []() {
+                    return std::make_unique<aecs::wrapped_container<T>>();
+                });
+            loc = move_entity(e, target);
+        }
+
+        archetype(loc.archetype).template get<T>()[loc.row] =
+            T(std::forward<Args>(args)...);
+        mark_changed<T>(loc);
+    }
+
+    // remove T from e, does nothing if e has no T.
+    template<typename T>
+    void remove(aecs::entity::id e)
+    {
+        const auto loc  = entities_.locate(e);
+        const auto hash = aecs::component_type<T>::hash();
+
+        if (archetype(loc.archetype).has_component(hash))
+        {
+            move_entity(e, remove_transition(loc.archetype, hash));
+        }
+    }
+
+    // Bulk operations, mostly used by command_buffer. Entities are grouped by
+    // their archetype so every group is moved with a single move_rows or
+    // swap_pop_sorted. Dead entities are skipped, an entity passed more than
+    // once only counts once, for add the last value wins.
+
+    // create an entity for every row of staging, which is left empty.
+    // Throws std::invalid_argument if a column of staging stores a component
+    // with a different container or element layout than this world.
+    void spawn(aecs::archetype& staging)
+    {
+        if (staging.empty())
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i != staging.column_count(); ++i)
+        {
+            check_column(staging.column(i));
+        }
+
+        auto it       = archetype_lookup_.find(staging.hashes());
+        auto arch_idx = it != archetype_lookup_.end()
+                            ? it->second
+                            : insert_archetype(staging.replicate());
+        auto& arch = archetype(arch_idx);
+
+        const auto first = arch.size();
+        auto       ids   = std::vector<aecs::entity::id>{};
+        ids.reserve(staging.size());
+
+        for (std::size_t i = 0; i != staging.size(); ++i)
+        {
+            ids.push_back(entities_.create(aecs::entity::location{
+                arch_idx, static_cast<std::uint32_t>(first + i)}));
+        }
+
+        arch.append(staging, ids.data());
+        arch.mark_rows_changed(first, arch.size(), version_);
+        staging = staging.replicate();
+    }
+
+    void destroy(const aecs::entity::id* es, std::size_t count)
+    {
+        for_each_group(es, count, [&](std::uint32_t arch_idx, group& g) {
+            auto& arch = archetype(arch_idx);
+            arch.swap_pop_sorted(g.rows.data(), g.rows.size());
+            fix_moved(arch, g.rows);
+
+            for (auto e : g.entities)
+            {
+                entities_.destroy(e);
+            }
+        });
+    }
+
+    // add the component of values to every entity, es[i] receives element i
+    // of values. Entities which already have it are overwritten. Throws
+    // std::invalid_argument if the component is stored with a different
+    // container or element layout than values.
+    void add(const aecs::polymorphic_container& values,
+             const aecs::entity::id*            es,
+             std::size_t                        count)
+    {
+        assert(values.size() >= count);
+        check_column(values);
+        const auto hash = values.component_hash();
+
+        for_each_group(es, count, [&](std::uint32_t arch_idx, group& g) {
+            if (archetype(arch_idx).has_component(hash))
+            {
+                auto& arch = archetype(arch_idx);
+                auto& col  = arch.column(arch.column_index(hash));
+
+                for (std::size_t i = 0; i != g.rows.size(); ++i)
+                {
+                    col.assign_from(g.rows[i], values, g.positions[i]);
+                    arch.mark_row_changed(g.rows[i], version_);
+                }
+
+                return;
+            }
+
+            const auto target = add_transition(
+                arch_idx, hash, [&]() { return values.replicate(); });
+            const auto first = move_group(arch_idx, target, g);
+
+            auto& dst = archetype(target);
+            auto& col = dst.column(dst.column_index(hash));
+
+            for (std::size_t i = 0; i != g.rows.size(); ++i)
+            {
+                col.assign_from(first + i, values, g.positions[i]);
+            }
+        });
+    }
+
+    // remove the component with hash from every entity which has it.
+    void remove(std::size_t hash, const aecs::entity::id* es, std::size_t count)
+    {
+        for_each_group(es, count, [&](std::uint32_t arch_idx, group& g) {
+            if (archetype(arch_idx).has_component(hash))
+            {
+                move_group(arch_idx, remove_transition(arch_idx, hash), g);
+            }
+        });
+    }
+
+    // reorder the rows of archetype idx, row i becomes the row previously at
+    // order[i] in every column. The entities follow their rows and all rows
+    // are marked changed.
+    void permute_rows(std::size_t idx, const std::size_t* order)
+    {
+        auto& arch = archetype(idx);
+        arch.permute(order);
+
+        for (std::size_t row = 0; row != arch.size(); ++row)
+        {
+            entities_.locate(arch.entities()[row]).row =
+                static_cast<std::uint32_t>(row);
+        }
+
+        arch.mark_rows_changed(0, arch.size(), version_);
+    }
+
+private:
+    // the rows of some entities within one archetype
+    struct group
+    {
+        std::vector<std::size_t>      rows;
+        std::vector<aecs::entity::id> entities;
+        // index of every entity in the array passed to the bulk operation
+        std::vector<std::size_t> positions;
+    };
+
+    // call fn(archetype index, group) for every archetype containing one of
+    // the alive entities, rows are ascending and unique.
+    template<typename F>
+    void for_each_group(const aecs::entity::id* es, std::size_t count, F&& fn)
+    {
+        struct entry
+        {
+            aecs::entity::location loc;
+            std::size_t            pos;
+        };
+
+        auto entries = std::vector<entry>{};
+        entries.reserve(count);
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            if (entities_.alive(es[i]))
+            {
+                entries.push_back(entry{entities_.locate(es[i]), i});
+            }
+        }
+
+        // stable, so among duplicates the last passed comes last
+        std::stable_sort(
+            entries.begin(), entries.end(), [](const auto& l, const auto& r) {
+                return l.loc.archetype != r.loc.archetype
+                           ? l.loc.archetype < r.loc.archetype
+                           : l.loc.row < r.loc.row;
+            });
+
+        auto g = group{};
+
+        for (std::size_t i = 0; i != entries.size();)
+        {
+            const auto arch_idx = entries[i].loc.archetype;
+            const auto& ents    = archetype(arch_idx).entities();
+
+            g.rows.clear();
+            g.entities.clear();
+            g.positions.clear();
+
+            for (; i != entries.size() && entries[i].loc.archetype == arch_idx;
+                 ++i)
+            {
+                const auto row = entries[i].loc.row;
+
+                if (!g.rows.empty() && g.rows.back() == row)
+                {
+                    g.positions.back() = entries[i].pos;
+                    continue;
+                }
+
+                g.rows.push_back(row);
+                g.entities.push_back(ents[row]);
+                g.positions.push_back(entries[i].pos);
+            }
+
+            fn(arch_idx, g);
+        }
+    }
+
+    // move all rows of g from src to target, returns the first row in target.
+    std::size_t move_group(std::uint32_t src, std::uint32_t target, group& g)
+    {
+        auto& arch = archetype(src);
+        auto& dst  = archetype(target);
+
+        const auto first = arch.move_rows(g.rows.data(), g.rows.size(), dst);
+
+        for (std::size_t i = 0; i != g.entities.size(); ++i)
+        {
+            entities_.locate(g.entities[i]) = aecs::entity::location{
+                target, static_cast<std::uint32_t>(first + i)};
+        }
+
+        dst.mark_rows_changed(first, dst.size(), version_);
+        fix_moved(arch, g.rows);
+        return first;
+    }
+
+    template<typename T>
+    void mark_changed(aecs::entity::location loc) noexcept
+    {
+        auto& arch = archetype(loc.archetype);
+        arch.mark_changed(arch.column_index(aecs::component_type<T>::hash()),
+                          loc.row / aecs::archetype::chunk_rows,
+                          version_);
+    }
+
+    template<typename... Ts>
+    static std::vector<std::size_t> make_signature()
+    {
+        auto sig =
+            std::vector<std::size_t>{aecs::component_type<Ts>::hash()...};
+        std::sort(sig.begin(), sig.end());
+        assert(std::adjacent_find(sig.begin(), sig.end()) == sig.end() &&
+               "component types must be unique");
+        return sig;
+    }
+
+    template<typename... Ts>
+    std::uint32_t archetype_index()
+    {
+        static const auto sig = make_signature<Ts...>();
+
+        auto it = archetype_lookup_.find(sig);
+
+        if (it != archetype_lookup_.end())
+        {
+            return it->second;
+        }
+
+        return insert_archetype(aecs::archetype{std::in_place_type<Ts>...});
+    }
+
+    // throws if the hash of col is stored with a different implementation,
+    // or with elements of a different size or alignment, such as two
+    // descriptors of the same name.
+    void check_column(const aecs::polymorphic_container& col) const
+    {
+        auto it = column_types_.find(col.component_hash());
+
+        if (it != column_types_.end() && !(it->second == column_type{col}))
+        {
+            throw std::invalid_argument{
+                "component is stored with a different container type"};
+        }
+    }
+
+    std::uint32_t insert_archetype(aecs::archetype&& arch)
+    {
+        assert(archetype_lookup_.count(arch.hashes()) == 0);
+
+        for (std::size_t i = 0; i != arch.column_count(); ++i)
+        {
+            check_column(arch.column(i));
+        }
+
+        for (std::size_t i = 0; i != arch.column_count(); ++i)
+        {
+            const auto& col = arch.column(i);
+            column_types_.emplace(col.component_hash(), column_type{col});
+        }
+
+        const auto idx  = static_cast<std::uint32_t>(archetypes_.size());
+        const auto mask = components_.make_mask(arch.hashes().begin(),
+                                                arch.hashes().end());
+        archetype_lookup_.emplace(arch.hashes(), idx);
+        archetypes_.push_back(archetype_node{
+            std::make_unique<aecs::archetype>(std::move(arch)), mask, {}, {}});
+        return idx;
+    }
+
+    // find or create the archetype of src with hash added. make_column is only
+    // invoked if the archetype has to be created.
+    template<typename F>
+    std::uint32_t
+        add_transition(std::uint32_t src, std::size_t hash, F&& make_column)
+    {
+        auto edge = archetypes_[src].add_edges.find(hash);
+
+        if (edge != archetypes_[src].add_edges.end())
+        {
+            return edge->second;
+        }
+
+        auto sig = archetype(src).hashes();
+        sig.insert(std::lower_bound(sig.begin(), sig.end(), hash), hash);
+
+        auto it     = archetype_lookup_.find(sig);
+        auto target = it != archetype_lookup_.end()
+                          ? it->second
+                          : insert_archetype(archetype(src).extend(
+                                std::forward<F>(make_column)()));
+
+        archetypes_[src].add_edges.emplace(hash, target);
+        archetypes_[target].remove_edges.emplace(hash, src);
+        return target;
+    }
+
+    std::uint32_t remove_transition(std::uint32_t src, std::size_t hash)
+    {
+        auto edge = archetypes_[src].remove_edges.find(hash);
+
+        if (edge != archetypes_[src].remove_edges.end())
+        {
+            return edge->second;
+        }
+
+        auto sig = archetype(src).hashes();
+        sig.erase(std::lower_bound(sig.begin(), sig.end(), hash));
+
+        auto it     = archetype_lookup_.find(sig);
+        auto target = it != archetype_lookup_.end()
+                          ? it->second
+                          : insert_archetype(archetype(src).reduce(hash));
+
+        archetypes_[src].remove_edges.emplace(hash, target);
+        archetypes_[target].add_edges.emplace(hash, src);
+        return target;
+    }
+
+    // move the row of e to the target archetype, returns the new location.
+    aecs::entity::location move_entity(aecs::entity::id e,
+                                       std::uint32_t    target)
+    {
+        auto& loc = entities_.locate(e);
+        auto& src = archetype(loc.archetype);
+
+        const auto row = src.move_row(loc.row, archetype(target));
+        fix_moved(src, loc.row);
+
+        loc = aecs::entity::location{target, static_cast<std::uint32_t>(row)};
+        archetype(target).mark_row_changed(row, version_);
+        return loc;
+    }
+
+    void remove_row(aecs::entity::location loc)
+    {
+        auto& arch = archetype(loc.archetype);
+        arch.swap_pop(loc.row);
+        fix_moved(arch, loc.row);
+    }
+
+    // after a swap_pop the last row of arch moved into row, update the
+    // location of the entity stored there.
+    void fix_moved(aecs::archetype& arch, std::uint32_t row) noexcept
+    {
+        if (row < arch.size())
+        {
+            entities_.locate(arch.entities()[row]).row = row;
+            arch.mark_row_changed(row, version_);
+        }
+    }
+
+    // the bulk version, rows were removed with swap_pop_sorted.
+    void fix_moved(aecs::archetype&                arch,
+                   const std::vector<std::size_t>& rows) noexcept
+    {
+        for (auto row : rows)
+        {
+            fix_moved(arch, static_cast<std::uint32_t>(row));
+        }
+    }
+};
+} // namespace aecs
\ No newline at end of file
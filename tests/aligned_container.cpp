@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+
+#include "aecs/container/aligned.hpp"
+#include "aecs/container/wrapped.hpp"
+
+namespace
+{
+struct mass
+{
+    using container_type = aecs::aligned_container<mass, 32>;
+
+    float value;
+};
+
+struct rgb
+{
+    unsigned char r, g, b;
+};
+
+template<typename T>
+bool is_aligned(const T* ptr, std::size_t align)
+{
+    return reinterpret_cast<std::uintptr_t>(ptr) % align == 0;
+}
+} // namespace
+
+TEST_CASE("aligned_container")
+{
+    static_assert(aecs::aligned_container<float>::padding_granularity == 16);
+    static_assert(aecs::aligned_container<double, 32>::padding_granularity ==
+                  4);
+    static_assert(aecs::aligned_container<rgb>::padding_granularity == 64);
+
+    auto cont = aecs::aligned_container<float>{};
+
+    REQUIRE(cont.size() == 0);
+    REQUIRE(cont.padded_size() == 0);
+
+    for (auto i = 0; i < 20; ++i)
+    {
+        cont.push_back(static_cast<float>(i + 1));
+    }
+
+    REQUIRE(is_aligned(cont.data(), 64));
+    REQUIRE(cont.size() == 20);
+    REQUIRE(cont.padded_size() == 32);
+    REQUIRE(cont.capacity() % 16 == 0);
+
+    // the padding is zero filled
+    for (auto i = cont.size(); i < cont.padded_size(); ++i)
+    {
+        REQUIRE(cont.data()[i] == 0.0f);
+    }
+
+    cont.swap_pop(0);
+    REQUIRE(cont[0] == 20);
+    REQUIRE(cont.data()[19] == 0.0f);
+
+    cont.resize(4);
+    REQUIRE(cont.padded_size() == 16);
+    for (auto i = cont.size(); i < cont.padded_size(); ++i)
+    {
+        REQUIRE(cont.data()[i] == 0.0f);
+    }
+
+    // kernel without remainder handling
+    auto sum = 0.0f;
+    for (auto i = std::size_t{0}; i < cont.padded_size(); ++i)
+    {
+        sum += cont.data()[i];
+    }
+    REQUIRE(sum == 20 + 2 + 3 + 4);
+
+    auto copy = cont;
+    REQUIRE(is_aligned(copy.data(), 64));
+    REQUIRE(copy.size() == 4);
+    REQUIRE(copy[0] == 20);
+
+    SECTION("make_container")
+    {
+        auto wrapped = aecs::wrapped_container<mass>{};
+        auto& poly   = static_cast<aecs::polymorphic_container&>(wrapped);
+
+        mass values[3] = {{1}, {2}, {3}};
+        poly.append(values, 3);
+        poly.push_back<mass>(mass{4});
+
+        const std::size_t rows[] = {0, 1};
+        poly.swap_pop_sorted(rows, 2);
+
+        REQUIRE(is_aligned(wrapped.get().data(), 32));
+        REQUIRE(poly.size() == 2);
+        REQUIRE(wrapped.get()[0].value == 3);
+        REQUIRE(wrapped.get()[1].value == 4);
+        REQUIRE(wrapped.get().data()[2].value == 0);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+
+#include "aecs/container/archetype.hpp"
+
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct frozen
+{};
+
+TEST_CASE("archetype")
+{
+    auto pv = aecs::archetype{std::in_place_type<position>,
+                              std::in_place_type<velocity>};
+
+    REQUIRE(pv.size() == 0);
+    REQUIRE(pv.column_count() == 2);
+    REQUIRE(pv.has_component<position>());
+    REQUIRE(pv.has_component<velocity>());
+    REQUIRE(!pv.has_component<frozen>());
+    REQUIRE(std::is_sorted(pv.hashes().begin(), pv.hashes().end()));
+
+    // order of the values does not matter
+    const auto e0 = aecs::entity::id{0, 0};
+    const auto e1 = aecs::entity::id{1, 0};
+    const auto e2 = aecs::entity::id{2, 0};
+
+    pv.push_back(e0, position{1, 1}, velocity{10, 10});
+    pv.push_back(e1, velocity{20, 20}, position{2, 2});
+    pv.push_back(e2, position{3, 3}, velocity{30, 30});
+
+    REQUIRE(pv.size() == 3);
+    REQUIRE(pv.get<position>()[1].x == 2);
+    REQUIRE(pv.get<velocity>()[1].dx == 20);
+
+    SECTION("swap_pop")
+    {
+        pv.swap_pop(0);
+
+        REQUIRE(pv.size() == 2);
+        REQUIRE(pv.get<position>().size() == 2);
+        REQUIRE(pv.get<velocity>().size() == 2);
+        REQUIRE(pv.get<position>()[0].x == 3);
+        REQUIRE(pv.get<velocity>()[0].dx == 30);
+        REQUIRE(pv.entities()[0] == e2);
+    }
+
+    SECTION("extend")
+    {
+        auto pvf = pv.extend<frozen>();
+
+        REQUIRE(pvf.size() == 0);
+        REQUIRE(pvf.column_count() == 3);
+        REQUIRE(pvf.has_component<frozen>());
+
+        auto row = pv.move_row(1, pvf);
+
+        REQUIRE(row == 0);
+        REQUIRE(pv.size() == 2);
+        REQUIRE(pvf.size() == 1);
+        REQUIRE(pvf.get<frozen>().size() == 1);
+        REQUIRE(pvf.get<position>()[0].x == 2);
+        REQUIRE(pvf.get<velocity>()[0].dx == 20);
+        REQUIRE(pvf.entities()[0] == e1);
+
+        // the last row moved into the hole
+        REQUIRE(pv.get<position>()[1].x == 3);
+    }
+
+    SECTION("move_rows")
+    {
+        auto pvf = pv.extend<frozen>();
+
+        const std::size_t rows[] = {0, 2};
+        auto              first  = pv.move_rows(rows, 2, pvf);
+
+        REQUIRE(first == 0);
+        REQUIRE(pv.size() == 1);
+        REQUIRE(pvf.size() == 2);
+        REQUIRE(pvf.get<frozen>().size() == 2);
+        REQUIRE(pvf.get<position>()[0].x == 1);
+        REQUIRE(pvf.get<velocity>()[1].dx == 30);
+        REQUIRE(pv.get<position>()[0].x == 2);
+        REQUIRE(pv.entities()[0] == e1);
+        REQUIRE(pvf.entities()[1] == e2);
+    }
+
+    SECTION("reduce")
+    {
+        auto p = pv.reduce<velocity>();
+
+        REQUIRE(p.column_count() == 1);
+        REQUIRE(p.has_component<position>());
+
+        pv.move_row(2, p);
+        pv.move_row(0, p);
+
+        REQUIRE(pv.size() == 1);
+        REQUIRE(p.size() == 2);
+        REQUIRE(p.get<position>()[0].x == 3);
+        REQUIRE(p.get<position>()[1].x == 1);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "aecs/container/bit_tag.hpp"
+#include "aecs/world/world.hpp"
+
+namespace
+{
+struct is_active
+{
+    using container_type = aecs::bit_tag_container<is_active>;
+};
+
+struct position
+{
+    float x, y;
+};
+
+struct frozen
+{};
+} // namespace
+
+TEST_CASE("bit_tag_container")
+{
+    static_assert(std::is_same_v<aecs::component_container_t<is_active>,
+                                 aecs::bit_tag_container<is_active>>);
+
+    auto cont = aecs::bit_tag_container<is_active>{};
+
+    for (auto i = 0; i < 200; ++i)
+    {
+        cont.push_back(i % 3 == 0);
+    }
+
+    REQUIRE(cont.size() == 200);
+    REQUIRE(cont.word_count() == 4);
+    REQUIRE(cont.count() == 67);
+    REQUIRE(cont[3]);
+    REQUIRE(!cont[4]);
+
+    SECTION("for_each_set")
+    {
+        auto rows = std::vector<std::size_t>{};
+        cont.for_each_set([&](std::size_t row) { rows.push_back(row); });
+
+        REQUIRE(rows.size() == 67);
+
+        for (std::size_t i = 0; i != rows.size(); ++i)
+        {
+            REQUIRE(rows[i] == 3 * i);
+        }
+
+        rows.clear();
+        cont.for_each_set(
+            60, 130, [&](std::size_t row) { rows.push_back(row); });
+        REQUIRE(rows.front() == 60);
+        REQUIRE(rows.back() == 129);
+        REQUIRE(rows.size() == cont.count(60, 130));
+        REQUIRE(rows.size() == 24);
+    }
+
+    SECTION("toggle")
+    {
+        cont[4] = true;
+        cont[3] = false;
+        cont[5].flip();
+        cont.push_back(is_active{});
+
+        REQUIRE(cont[4]);
+        REQUIRE(!cont[3]);
+        REQUIRE(cont[5]);
+        REQUIRE(cont.back());
+        REQUIRE(cont.count() == 69);
+    }
+
+    SECTION("swap_pop")
+    {
+        // row 198 is enabled, 199 isn't
+        cont.swap_pop(0);
+        REQUIRE(!cont[0]);
+        REQUIRE(cont.size() == 199);
+
+        cont.swap_pop(1);
+        REQUIRE(cont[1]);
+        REQUIRE(cont.size() == 198);
+        REQUIRE(cont.count() == 66);
+
+        while (cont.size() != 128)
+        {
+            cont.pop_back();
+        }
+
+        REQUIRE(cont.word_count() == 2);
+        REQUIRE(cont.count(0, 128) == cont.count());
+    }
+
+    SECTION("append_bits")
+    {
+        auto copy = aecs::bit_tag_container<is_active>{};
+
+        // starts word aligned, then continues at an offset of 5
+        copy.append_bits(cont.words(), 130);
+        copy.append_bits(cont.words(), 200);
+        REQUIRE(copy.size() == 330);
+        REQUIRE(copy.word_count() == 6);
+
+        for (std::size_t i = 0; i != 330; ++i)
+        {
+            REQUIRE(copy[i] == cont[i < 130 ? i : i - 130]);
+        }
+
+        REQUIRE(copy.count() == cont.count(0, 130) + cont.count());
+    }
+}
+
+TEST_CASE("bit_tag_container world")
+{
+    auto w   = aecs::world{};
+    auto ids = std::vector<aecs::entity::id>{};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        ids.push_back(w.create(position{float(i), 0}, is_active{}));
+    }
+
+    auto& arch = w.archetype(1);
+    auto& bits = arch.get<is_active>();
+    REQUIRE(bits.count() == 100);
+
+    // toggling doesn't move anything
+    for (std::size_t i = 0; i < ids.size(); i += 2)
+    {
+        w.get<is_active>(ids[i]) = false;
+    }
+
+    REQUIRE(w.archetype_count() == 2);
+    REQUIRE(bits.count() == 50);
+
+    // bits follow their entity between archetypes
+    w.add<frozen>(ids[1]);
+    w.add<frozen>(ids[2]);
+    w.destroy(ids[3]);
+
+    REQUIRE(w.get<is_active>(ids[1]));
+    REQUIRE(!w.get<is_active>(ids[2]));
+    REQUIRE(bits.count() == 48);
+
+    auto sum = 0.0f;
+    bits.for_each_set(
+        [&](std::size_t row) { sum += arch.get<position>()[row].x; });
+
+    // odd positions except 1 and 3
+    REQUIRE(sum == 2500.0f - 4.0f);
+}
\ No newline at end of file
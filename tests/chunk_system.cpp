@@ -0,0 +1,133 @@
+#include <catch2/catch.hpp>
+
+#include <type_traits>
+
+#include "aecs/container/aligned.hpp"
+#include "aecs/system/chunk_system.hpp"
+#include "aecs/system/scheduler.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+
+    using container_type = aecs::aligned_container<velocity>;
+};
+
+struct frozen
+{};
+
+using aecs::entity::access;
+using aecs::entity::static_constraint;
+
+using write_position = static_constraint<access::write, position>;
+using read_velocity  = static_constraint<access::read, velocity>;
+using exclude_frozen = static_constraint<access::exclude, frozen>;
+} // namespace
+
+TEST_CASE("chunk_system")
+{
+    auto w = aecs::world{};
+
+    for (auto i = 0; i < 10000; ++i)
+    {
+        w.create(position{0, 0}, velocity{1, float(i)});
+    }
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        w.create(position{0, 0}, velocity{1, 1}, frozen{});
+    }
+
+    const auto dt = 0.5f;
+
+    using move_system =
+        aecs::chunk_system<sizeof(float),
+                           write_position,
+                           read_velocity,
+                           exclude_frozen>;
+
+    // excluded components aren't passed
+    static_assert(
+        std::is_same_v<move_system::signature,
+                       void(aecs::column_span<position>,
+                            aecs::column_span<const velocity>)>);
+
+    const auto move = move_system{[dt](aecs::column_span<position>       pos,
+                                       aecs::column_span<const velocity> vel) {
+        for (std::size_t i = 0; i != pos.size(); ++i)
+        {
+            pos[i].x += vel[i].dx * dt;
+            pos[i].y += vel[i].dy * dt;
+        }
+    }};
+
+    auto check = [&](float steps) {
+        auto& arch = w.archetype(1);
+        auto& pos  = arch.get<position>();
+
+        for (std::size_t i = 0; i != arch.size(); ++i)
+        {
+            REQUIRE(pos[i].x == steps * dt);
+            REQUIRE(pos[i].y == steps * dt * float(i));
+        }
+
+        // frozen entities never move
+        REQUIRE(w.archetype(2).get<position>()[0].x == 0);
+    };
+
+    SECTION("direct")
+    {
+        move(w);
+        check(1);
+
+        auto pool = aecs::thread_pool{2};
+        move(w, pool);
+        check(2);
+    }
+
+    SECTION("scheduler")
+    {
+        auto sched = aecs::scheduler{};
+        sched.add_system(move);
+        sched.add_system(move);
+
+        REQUIRE(sched.size() == 2);
+        REQUIRE(sched.depends_on(1, 0));
+
+        auto pool = aecs::thread_pool{2};
+        sched.run(w, pool);
+        check(2);
+    }
+
+    SECTION("capacity")
+    {
+        struct state
+        {
+            float scale[8];
+        };
+
+        const auto s = state{{2, 2, 2, 2, 2, 2, 2, 2}};
+
+        // larger captures need a scheduler with more room
+        auto sched = aecs::basic_scheduler<64>{};
+        sched.add_system(
+            aecs::chunk_system<sizeof(state), write_position>{
+                [s](aecs::column_span<position> pos) {
+                    for (auto& p : pos)
+                    {
+                        p.x += s.scale[0];
+                    }
+                }});
+
+        sched.run(w);
+        REQUIRE(w.archetype(1).get<position>()[5].x == 2);
+        REQUIRE(w.archetype(2).get<position>()[5].x == 2);
+    }
+}
\ No newline at end of file
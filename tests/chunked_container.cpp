@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+
+#include "aecs/container/chunked.hpp"
+#include "aecs/container/wrapped.hpp"
+
+struct chunked_component
+{
+    using container_type = aecs::chunked_container<chunked_component>;
+
+    int i;
+};
+
+struct large_component
+{
+    char data[20000];
+};
+
+TEST_CASE("chunked_container")
+{
+    using cont_type = aecs::chunked_container<int, 64>;
+
+    static_assert(cont_type::elements_per_block == 16);
+    static_assert(
+        aecs::chunked_container<large_component>::elements_per_block == 1);
+    static_assert(aecs::chunked_container<std::array<char, 3>, 64>::
+                      elements_per_block == 16);
+    // 1365 elements fit, rounded down to 1024 for shift and mask indexing
+    static_assert(aecs::chunked_container<std::array<char, 12>>::
+                      elements_per_block == 1024);
+    static_assert(
+        aecs::chunked_container<std::array<char, 12>>::block_bytes == 12288);
+
+    auto cont = cont_type{};
+
+    REQUIRE(cont.size() == 0);
+    REQUIRE(cont.begin() == cont.end());
+
+    cont.push_back(0);
+    const int* first = &cont[0];
+
+    for (auto i = 1; i < 100; ++i)
+    {
+        cont.push_back(i);
+    }
+
+    REQUIRE(cont.size() == 100);
+    REQUIRE(cont.block_count() == 7);
+    REQUIRE(cont.block_size(6) == 4);
+
+    // growing never moves elements
+    REQUIRE(first == &cont[0]);
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        REQUIRE(cont[i] == i);
+    }
+
+    REQUIRE(std::distance(cont.begin(), cont.end()) == 100);
+    REQUIRE(*(cont.begin() + 50) == 50);
+
+    auto sum = 0;
+    for (auto i : cont)
+    {
+        sum += i;
+    }
+    REQUIRE(sum == 4950);
+
+    cont.swap_pop(3);
+    REQUIRE(cont.size() == 99);
+    REQUIRE(cont[3] == 99);
+    REQUIRE(cont.back() == 98);
+
+    auto copy = cont;
+    REQUIRE(copy.size() == cont.size());
+    REQUIRE(&copy[0] != &cont[0]);
+    REQUIRE(copy[3] == 99);
+
+    cont.clear();
+    cont.shrink_to_fit();
+    REQUIRE(cont.block_count() == 0);
+
+    SECTION("make_container")
+    {
+        static_assert(
+            std::is_same_v<aecs::chunked_container<chunked_component>,
+                           aecs::component_container_t<chunked_component>>);
+
+        auto wrapped = aecs::wrapped_container<chunked_component>{};
+        auto& poly   = static_cast<aecs::polymorphic_container&>(wrapped);
+
+        poly.push_back<chunked_component>(chunked_component{1});
+        poly.push_back<chunked_component>(chunked_component{2});
+        poly.push_back<chunked_component>(chunked_component{3});
+
+        poly.swap_pop(0);
+
+        REQUIRE(poly.size() == 2);
+        REQUIRE(wrapped.get()[0].i == 3);
+        REQUIRE(poly[1].get<chunked_component>().i == 2);
+    }
+}
\ No newline at end of file
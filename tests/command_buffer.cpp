@@ -0,0 +1,223 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "aecs/world/command_buffer.hpp"
+#include "aecs/world/query.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct frozen
+{};
+} // namespace
+
+TEST_CASE("command_buffer")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+
+    auto w   = aecs::world{};
+    auto ids = std::vector<aecs::entity::id>{};
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        ids.push_back(w.create(position{float(i), 0}, velocity{1, 1}));
+    }
+
+    auto cb = aecs::command_buffer{};
+    REQUIRE(cb.empty());
+
+    SECTION("spawn")
+    {
+        cb.spawn(position{1, 1}, velocity{1, 1});
+        cb.spawn(velocity{2, 2}, position{2, 2});
+        cb.spawn(position{3, 3});
+        REQUIRE(!cb.empty());
+        REQUIRE(w.size() == 10);
+
+        cb.flush(w);
+        REQUIRE(cb.empty());
+        REQUIRE(w.size() == 13);
+        REQUIRE(w.archetype(1).size() == 12);
+
+        // ids of spawned entities are valid
+        const auto e = w.archetype(1).entities().back();
+        REQUIRE(w.alive(e));
+        REQUIRE(w.get<position>(e).x == 2);
+
+        // staging is reused
+        cb.spawn(position{4, 4});
+        cb.flush(w);
+        REQUIRE(w.size() == 14);
+    }
+
+    SECTION("add remove")
+    {
+        for (std::size_t i = 0; i < ids.size(); i += 2)
+        {
+            cb.add<frozen>(ids[i]);
+        }
+
+        cb.add<velocity>(ids[1], velocity{5, 5});
+        cb.remove<velocity>(ids[3]);
+        cb.remove<frozen>(ids[3]);
+
+        cb.flush(w);
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            REQUIRE(w.has<frozen>(ids[i]) == (i % 2 == 0));
+            REQUIRE(w.get<position>(ids[i]).x == float(i));
+        }
+
+        REQUIRE(w.get<velocity>(ids[1]).dx == 5);
+        REQUIRE(!w.has<velocity>(ids[3]));
+        REQUIRE(w.has<velocity>(ids[5]));
+    }
+
+    SECTION("add values")
+    {
+        // added values follow their entity through the batch
+        cb.add<frozen>(ids[4]);
+        cb.add<frozen>(ids[7]);
+        cb.flush(w);
+
+        cb.remove<velocity>(ids[9]);
+        cb.remove<velocity>(ids[4]);
+        cb.remove<velocity>(ids[0]);
+        cb.flush(w);
+
+        REQUIRE(!w.has<velocity>(ids[0]));
+        REQUIRE(!w.has<velocity>(ids[4]));
+        REQUIRE(!w.has<velocity>(ids[9]));
+
+        cb.add<velocity>(ids[9], velocity{9, 0});
+        cb.add<velocity>(ids[0], velocity{0, 0});
+        cb.add<velocity>(ids[4], velocity{4, 0});
+        cb.add<velocity>(ids[4], velocity{44, 0});
+        cb.flush(w);
+
+        REQUIRE(w.get<velocity>(ids[9]).dx == 9);
+        REQUIRE(w.get<velocity>(ids[0]).dx == 0);
+        REQUIRE(w.get<velocity>(ids[4]).dx == 44);
+        REQUIRE(w.has<frozen>(ids[4]));
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            REQUIRE(w.get<position>(ids[i]).x == float(i));
+        }
+    }
+
+    SECTION("destroy")
+    {
+        cb.destroy(ids[0]);
+        cb.destroy(ids[5]);
+        cb.destroy(ids[9]);
+        cb.destroy(ids[5]);
+        cb.add<frozen>(ids[9]);
+
+        cb.flush(w);
+
+        REQUIRE(w.size() == 7);
+        REQUIRE(!w.alive(ids[0]));
+        REQUIRE(!w.alive(ids[5]));
+        REQUIRE(!w.alive(ids[9]));
+
+        for (auto i : {1, 2, 3, 4, 6, 7, 8})
+        {
+            REQUIRE(w.get<position>(ids[i]).x == float(i));
+        }
+
+        // commands on dead entities are ignored
+        cb.destroy(ids[0]);
+        cb.add<frozen>(ids[0]);
+        cb.flush(w);
+        REQUIRE(w.size() == 7);
+    }
+
+    SECTION("custom")
+    {
+        auto count = 0;
+        cb.push([&count](aecs::world& wld) { count = int(wld.size()); });
+        cb.destroy(ids[0]);
+        cb.flush(w);
+
+        // runs after the destroy
+        REQUIRE(count == 9);
+    }
+
+    SECTION("parallel")
+    {
+        auto pool = aecs::thread_pool{3};
+        auto pcb  = aecs::command_buffer{pool};
+
+        auto q = aecs::query{
+            w,
+            constraint_list{
+                constraint{access::read, std::in_place_type<position>}}};
+
+        for (auto i = 0; i < 5000; ++i)
+        {
+            w.create(position{-1, 0}, velocity{0, 0});
+        }
+
+        q.parallel_for_each(pool, [&](const aecs::chunk& c) {
+            const auto& pos = c.get<position>();
+
+            for (auto row = c.begin(); row != c.end(); ++row)
+            {
+                if (pos[row].x < 0)
+                {
+                    pcb.destroy(c.entity(row));
+                }
+                else
+                {
+                    pcb.add<frozen>(c.entity(row));
+                    pcb.spawn(position{pos[row].x, 1});
+                }
+            }
+        });
+
+        pcb.flush(w);
+
+        REQUIRE(w.size() == 20);
+
+        for (auto e : ids)
+        {
+            REQUIRE(w.has<frozen>(e));
+        }
+    }
+
+    SECTION("other pools")
+    {
+        auto pool  = aecs::thread_pool{3};
+        auto other = aecs::thread_pool{2};
+        auto pcb   = aecs::command_buffer{other};
+
+        // neither buffer has lanes for the workers of pool, they all record
+        // into the shared lane
+        pool.parallel_for(ids.size(), [&](std::size_t i) {
+            for (auto n = 0; n != 100; ++n)
+            {
+                cb.spawn(position{float(i), 0});
+                pcb.spawn(position{float(i), 1});
+            }
+        });
+
+        cb.flush(w);
+        pcb.flush(w);
+
+        REQUIRE(w.size() == ids.size() * 201);
+    }
+}
\ No newline at end of file
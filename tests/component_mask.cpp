@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "aecs/component/registry.hpp"
+#include "aecs/entity/constraint.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct health
+{
+    int value;
+};
+
+struct dead
+{};
+} // namespace
+
+TEST_CASE("component_mask")
+{
+    auto m = aecs::component_mask<128>{};
+
+    REQUIRE(m.none());
+
+    m.set(3);
+    m.set(100);
+
+    REQUIRE(m.test(3));
+    REQUIRE(m.test(100));
+    REQUIRE(!m.test(4));
+    REQUIRE(m.any());
+
+    auto other = aecs::component_mask<128>{};
+    other.set(100);
+
+    REQUIRE(m.intersects(other));
+    REQUIRE(m.contains(other));
+    REQUIRE(!other.contains(m));
+    REQUIRE((m & other) == other);
+    REQUIRE((m | other) == m);
+
+    m.reset(100);
+    REQUIRE(!m.intersects(other));
+}
+
+TEST_CASE("component_registry")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+    using aecs::entity::constraint_view;
+
+    auto reg = aecs::component_registry{};
+
+    const auto pos_hash = aecs::component_type<position>::hash();
+    const auto vel_hash = aecs::component_type<velocity>::hash();
+
+    REQUIRE(reg.find(pos_hash) == aecs::component_registry::invalid_index);
+    REQUIRE(reg.index(pos_hash) == 0);
+    REQUIRE(reg.index(vel_hash) == 1);
+    REQUIRE(reg.index(pos_hash) == 0);
+    REQUIRE(reg.find(vel_hash) == 1);
+    REQUIRE(reg.size() == 2);
+
+    SECTION("overflow")
+    {
+        auto small = aecs::basic_component_registry<64>{};
+
+        for (std::size_t h = 0; h != 64; ++h)
+        {
+            REQUIRE(small.index(h) == h);
+        }
+
+        REQUIRE_THROWS_AS(small.index(64), std::length_error);
+        REQUIRE(small.size() == 64);
+        REQUIRE(small.index(63) == 63);
+    }
+
+    SECTION("allow_parallelism")
+    {
+        // the same relation as the constraint_view comparisons
+        auto lists = std::vector<std::vector<constraint>>{
+            {constraint{access::write, std::in_place_type<position>},
+             constraint{access::read, std::in_place_type<velocity>}},
+            {constraint{access::read, std::in_place_type<position>}},
+            {constraint{access::read, std::in_place_type<velocity>}},
+            {constraint{access::exclude, std::in_place_type<dead>},
+             constraint{access::write, std::in_place_type<health>}},
+            {constraint{access::write, std::in_place_type<health>},
+             constraint{access::write, std::in_place_type<dead>}},
+            {constraint{access::write, std::in_place_type<velocity>}},
+        };
+
+        for (auto& l : lists)
+        {
+            std::sort(l.begin(), l.end());
+        }
+
+        for (const auto& a : lists)
+        {
+            for (const auto& b : lists)
+            {
+                const auto va = constraint_view{a.data(), a.data() + a.size()};
+                const auto vb = constraint_view{b.data(), b.data() + b.size()};
+
+                REQUIRE(reg.make_access_mask(va).allow_parallelism(
+                            reg.make_access_mask(vb)) ==
+                        va.allow_parallelism(vb));
+            }
+        }
+    }
+
+    SECTION("matches")
+    {
+        const auto cs = constraint_list{
+            constraint{access::read, std::in_place_type<position>},
+            constraint{access::exclude, std::in_place_type<dead>}};
+        const auto mask = reg.make_access_mask(cs);
+
+        const auto pos_vel =
+            std::vector<std::size_t>{pos_hash, vel_hash};
+        const auto pos_dead = std::vector<std::size_t>{
+            pos_hash, aecs::component_type<dead>::hash()};
+        const auto vel = std::vector<std::size_t>{vel_hash};
+
+        REQUIRE(mask.matches(reg.make_mask(pos_vel.begin(), pos_vel.end())));
+        REQUIRE(!mask.matches(reg.make_mask(pos_dead.begin(), pos_dead.end())));
+        REQUIRE(!mask.matches(reg.make_mask(vel.begin(), vel.end())));
+    }
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 
+#include "aecs/component/registry.hpp"
 #include "aecs/entity/constraint.hpp"
 
 TEST_CASE("constraint")
@@ -21,7 +22,7 @@ TEST_CASE("constraint")
         constraint_list{constraint{access::exclude, std::in_place_type<char>},
                         constraint{access::write, std::in_place_type<int>}};
 
-    // cannot be constructed as a constexpr
+    // sorted at construction, usable in constant expressions as well
     auto cs1 = constraint_view{c_arr1};
     auto cs2 = constraint_view{c_arr2};
     auto cs3 = constraint_view{c_arr3};
@@ -33,4 +34,54 @@ TEST_CASE("constraint")
     REQUIRE(!cs1.allow_parallelism(cs1));
     REQUIRE(!cs2.allow_parallelism(cs2));
     REQUIRE(!cs3.allow_parallelism(cs3));
+}
+
+TEST_CASE("constraint exclude order")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+    using aecs::entity::constraint_view;
+
+    // the exclude on float is only reached after the conflicting writes on
+    // int, it still makes the entity sets disjoint.
+    auto c_arr1 =
+        constraint_list{constraint{access::write, std::in_place_type<int>},
+                        constraint{access::read, std::in_place_type<float>}};
+
+    auto c_arr2 =
+        constraint_list{constraint{access::write, std::in_place_type<int>},
+                        constraint{access::exclude, std::in_place_type<float>}};
+
+    auto cs1 = constraint_view{c_arr1};
+    auto cs2 = constraint_view{c_arr2};
+
+    REQUIRE(cs1.allow_parallelism(cs2));
+    REQUIRE(cs2.allow_parallelism(cs1));
+
+    auto reg = aecs::component_registry{};
+
+    const auto m1 = reg.make_access_mask(cs1);
+    const auto m2 = reg.make_access_mask(cs2);
+
+    REQUIRE(m1.allow_parallelism(m2));
+    REQUIRE(m2.allow_parallelism(m1));
+}
+
+TEST_CASE("constexpr constraint_list")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint_list;
+    using aecs::entity::constraint_view;
+    using aecs::entity::static_constraint;
+
+    static constexpr auto cs =
+        constraint_list{static_constraint<access::read, int>{},
+                        static_constraint<access::exclude, char>{},
+                        static_constraint<access::write, float>{}};
+
+    static_assert(cs[0].access() == access::exclude);
+    static_assert(cs[1].access() == access::write);
+    static_assert(cs[2].access() == access::read);
+    static_assert(!constraint_view{cs}.allow_parallelism(constraint_view{cs}));
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "aecs/world/delta.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y, z;
+};
+
+struct health
+{
+    int value;
+};
+
+struct frozen
+{};
+} // namespace
+
+TEST_CASE("delta")
+{
+    auto sender   = aecs::world{};
+    auto receiver = aecs::world{};
+    auto ids      = std::vector<aecs::entity::id>{};
+
+    // equal ids on both sides, the receiver starts out all zero
+    for (auto i = 0; i < 5000; ++i)
+    {
+        ids.push_back(sender.create(
+            position{float(i), 1, 2}, health{100}, frozen{}));
+        REQUIRE(receiver.create(position{}, health{}, frozen{}) == ids.back());
+    }
+
+    auto send_base    = aecs::delta_baseline{};
+    auto receive_base = aecs::delta_baseline{};
+    auto data         = std::vector<unsigned char>{};
+
+    auto equal = [&]() {
+        for (auto e : ids)
+        {
+            if (sender.get<position>(e).x != receiver.get<position>(e).x ||
+                sender.get<position>(e).z != receiver.get<position>(e).z ||
+                sender.get<health>(e).value != receiver.get<health>(e).value)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    REQUIRE(aecs::encode_delta(sender, 0, send_base, data) == 2 * ids.size());
+    auto apply = [&]() {
+        return aecs::apply_delta(
+            receiver, data.data(), data.size(), receive_base);
+    };
+
+    REQUIRE(apply());
+    REQUIRE(equal());
+
+    SECTION("changed rows only")
+    {
+        const auto since = sender.advance_version();
+        receiver.advance_version();
+
+        for (std::size_t i = 0; i < ids.size(); i += 100)
+        {
+            sender.get<position>(ids[i]).x += 1;
+        }
+
+        // unchanged chunks aren't visited
+        data.clear();
+        REQUIRE(aecs::encode_delta(sender, since, send_base, data) == 50);
+
+        // only a few bytes of x differ, the rest is run-length encoded
+        REQUIRE(data.size() < 50 * (sizeof(aecs::entity::id) + 8) + 2 * 24);
+
+        const auto received = receiver.version();
+        REQUIRE(apply());
+        REQUIRE(equal());
+
+        // writes are marked like any other write
+        REQUIRE(receiver.archetype(1).changed_since(
+            receiver.archetype(1).column_index(
+                aecs::component_type<position>::hash()),
+            0,
+            received - 1));
+
+        // nothing changed since
+        data.clear();
+        REQUIRE(aecs::encode_delta(sender, since, send_base, data) == 0);
+        REQUIRE(data.empty());
+    }
+
+    SECTION("missing entities")
+    {
+        const auto since = sender.advance_version();
+        sender.get<health>(ids[3]).value = 5;
+        sender.get<health>(ids[4]).value = 6;
+        receiver.destroy(ids[3]);
+
+        data.clear();
+        REQUIRE(aecs::encode_delta(sender, since, send_base, data) == 2);
+        REQUIRE(apply());
+        REQUIRE(receiver.get<health>(ids[4]).value == 6);
+    }
+
+    SECTION("baseline")
+    {
+        const auto hash = aecs::component_type<health>::hash();
+
+        REQUIRE(send_base.find(hash, ids[7]) != nullptr);
+
+        // the index of a destroyed entity is reused by the next one
+        sender.destroy(ids[7]);
+        send_base.erase(ids[7]);
+        REQUIRE(send_base.find(hash, ids[7]) == nullptr);
+
+        const auto e = sender.create(position{}, health{100}, frozen{});
+        REQUIRE(e.index() == ids[7].index());
+        REQUIRE(send_base.find(hash, e) == nullptr);
+
+        // a new generation starts out from zero
+        const auto* value = send_base.get(hash, sizeof(health), e);
+        REQUIRE(send_base.find(hash, e) == value);
+        REQUIRE(value[0] == 0);
+        REQUIRE(send_base.find(hash, ids[7]) == nullptr);
+    }
+
+    SECTION("malformed")
+    {
+        const auto since = sender.advance_version();
+        sender.get<health>(ids[0]).value = 1;
+
+        data.clear();
+        aecs::encode_delta(sender, since, send_base, data);
+        REQUIRE(!aecs::apply_delta(
+            receiver, data.data(), data.size() - 1, receive_base));
+        REQUIRE(!aecs::apply_delta(receiver, data.data(), 4, receive_base));
+
+        // an entity index the receiver never had
+        auto e = aecs::entity::id{std::uint32_t(ids.size() + 10), 0};
+        std::memcpy(data.data() + sizeof(aecs::detail::delta::record),
+                    &e,
+                    sizeof(e));
+        REQUIRE(!aecs::apply_delta(
+            receiver, data.data(), data.size(), receive_base));
+
+        // a record of count values of element_size bytes, all literals
+        auto record = [&](std::size_t hash,
+                          std::uint32_t element_size,
+                          std::size_t zeros) {
+            auto encoded = std::vector<unsigned char>{};
+            aecs::detail::delta::write_varint(encoded, zeros);
+            aecs::detail::delta::write_varint(encoded,
+                                              element_size - zeros);
+            encoded.resize(encoded.size() + element_size - zeros, 1);
+
+            data.clear();
+            aecs::detail::delta::append_bytes(
+                data,
+                aecs::detail::delta::record{
+                    hash, 1, element_size, encoded.size()});
+            aecs::detail::delta::append_bytes(data, ids[0]);
+            data.insert(data.end(), encoded.begin(), encoded.end());
+        };
+
+        const auto hash = aecs::component_type<health>::hash();
+
+        // xored with the baseline of 100
+        const auto value = 100 ^ 0x01010101;
+
+        record(hash, sizeof(health), 0);
+        REQUIRE(apply());
+        REQUIRE(receiver.get<health>(ids[0]).value == value);
+
+        // larger than the baseline and the column of health
+        record(hash, 64, 0);
+        REQUIRE(!apply());
+        REQUIRE(receiver.get<health>(ids[0]).value == value);
+
+        // larger than the column of health, which isn't in the baseline yet
+        auto fresh = aecs::delta_baseline{};
+        REQUIRE(!aecs::apply_delta(
+            receiver, data.data(), data.size(), fresh));
+        REQUIRE(fresh.find(hash) == nullptr);
+
+        // a few bytes decoding to 4 GiB of a component nobody knows
+        record(hash + 1, 0xffffffff, 0xffffffff);
+        REQUIRE(data.size() < 64);
+        REQUIRE(!apply());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "aecs/container/dynamic.hpp"
+#include "aecs/world/world.hpp"
+
+namespace
+{
+struct position
+{
+    static constexpr auto name = "position";
+
+    float x, y;
+};
+
+struct health
+{
+    int value;
+};
+
+// the layout a script would describe
+struct alignas(16) script_value
+{
+    float         v[3];
+    std::uint32_t id;
+};
+
+int id_at(const aecs::dynamic_container& c, std::size_t idx)
+{
+    auto value = script_value{};
+    std::memcpy(&value, c.element(idx), sizeof(value));
+    return static_cast<int>(value.id);
+}
+} // namespace
+
+TEST_CASE("dynamic_container")
+{
+    auto desc = std::make_shared<const aecs::component_descriptor>(
+        "script_value", sizeof(script_value), alignof(script_value));
+
+    REQUIRE(desc->hash() == aecs::name_hash("script_value"));
+
+    // same algorithm as native components
+    REQUIRE(aecs::component_descriptor{"position", 8, 4}.hash() ==
+            aecs::component_type<position>::hash());
+
+    auto values = std::vector<script_value>(10);
+
+    for (std::uint32_t i = 0; i != values.size(); ++i)
+    {
+        values[i] = script_value{{float(i), 0, 0}, i};
+    }
+
+    SECTION("container")
+    {
+        std::unique_ptr<aecs::polymorphic_container> src =
+            std::make_unique<aecs::dynamic_container>(desc);
+        auto dst = src->replicate();
+
+        auto& real_src = static_cast<aecs::dynamic_container&>(*src);
+        auto& real_dst = static_cast<aecs::dynamic_container&>(*dst);
+
+        src->append(values.data(), values.size());
+        REQUIRE(src->size() == 10);
+        REQUIRE(src->component_name() == "script_value");
+        REQUIRE(reinterpret_cast<std::uintptr_t>(real_src.data()) % 16 == 0);
+        REQUIRE((*src)[4].ptr() == real_src.element(4));
+        REQUIRE((*src)[4].hash() == desc->hash());
+        REQUIRE(src->element_size() == sizeof(script_value));
+        REQUIRE(src->run_count() == 1);
+        REQUIRE(src->run(0).data == real_src.data());
+        REQUIRE(src->run(0).size == 10);
+
+        const std::size_t rows[] = {1, 2, 3, 7};
+        src->move_rows_to(*dst, rows, 4);
+
+        REQUIRE(dst->size() == 4);
+        REQUIRE(id_at(real_dst, 0) == 1);
+        REQUIRE(id_at(real_dst, 3) == 7);
+
+        // same result as swap_pop from the highest to the lowest index
+        auto expected = std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        for (auto it = std::rbegin(rows); it != std::rend(rows); ++it)
+        {
+            expected[*it] = expected.back();
+            expected.pop_back();
+        }
+
+        REQUIRE(src->size() == expected.size());
+        for (std::size_t i = 0; i != expected.size(); ++i)
+        {
+            REQUIRE(id_at(real_src, i) == expected[i]);
+        }
+
+        dst->assign_from(0, *src, 0);
+        dst->push_back_default();
+        REQUIRE(id_at(real_dst, 0) == expected[0]);
+        REQUIRE(id_at(real_dst, 4) == 0);
+
+        auto raw = std::vector<unsigned char>(src->raw_size(src->size()));
+        src->copy_raw(raw.data());
+        dst->append_raw(raw.data(), src->size());
+        REQUIRE(id_at(real_dst, 5) == expected[0]);
+    }
+
+    SECTION("tag")
+    {
+        auto tag = std::make_shared<const aecs::component_descriptor>(
+            "script_tag", 0, 1);
+        auto c = aecs::dynamic_container{tag};
+
+        c.push_back_default();
+        c.push_back_default();
+        c.swap_pop(0);
+
+        REQUIRE(c.size() == 1);
+        REQUIRE(c.raw_size(1) == 0);
+    }
+
+    SECTION("world")
+    {
+        auto w   = aecs::world{};
+        auto ids = std::vector<aecs::entity::id>{};
+
+        for (auto i = 0; i != 10; ++i)
+        {
+            ids.push_back(w.create(health{i}));
+        }
+
+        auto column = aecs::dynamic_container{desc};
+        column.append(values.data(), values.size());
+        w.add(column, ids.data(), ids.size());
+
+        const auto loc  = w.entities().locate(ids[3]);
+        auto&      arch = w.archetype(loc.archetype);
+
+        REQUIRE(arch.has_component(desc->hash()));
+        REQUIRE(arch.template has_component<health>());
+
+        auto& col = static_cast<aecs::dynamic_container&>(
+            arch.column(arch.column_index(desc->hash())));
+        REQUIRE(id_at(col, loc.row) == 3);
+
+        w.remove(desc->hash(), ids.data(), 5);
+        REQUIRE(!w.archetype(w.entities().locate(ids[3]).archetype)
+                     .has_component(desc->hash()));
+        REQUIRE(w.get<health>(ids[3]).value == 3);
+        REQUIRE(id_at(col, w.entities().locate(ids[8]).row) == 8);
+    }
+
+    SECTION("native hash")
+    {
+        // named like position, but not a wrapped_container<position>
+        auto alias = std::make_shared<const aecs::component_descriptor>(
+            "position", sizeof(position), alignof(position));
+        auto column = aecs::dynamic_container{alias};
+        column.push_back_default();
+
+        auto native = aecs::world{};
+        auto e      = native.create(position{1, 2});
+        auto other  = native.create(health{1});
+
+        REQUIRE_THROWS_AS(native.add(column, &other, 1),
+                          std::invalid_argument);
+        REQUIRE(!native.has<position>(other));
+        REQUIRE(native.get<position>(e).y == 2);
+
+        auto dynamic = aecs::world{};
+        auto d       = dynamic.create(health{1});
+        dynamic.add(column, &d, 1);
+
+        auto staging = aecs::archetype{std::in_place_type<position>};
+        staging.push_back(aecs::entity::id{}, position{3, 4});
+
+        REQUIRE_THROWS_AS(dynamic.spawn(staging), std::invalid_argument);
+        REQUIRE(dynamic.size() == 1);
+    }
+
+    SECTION("descriptor layout")
+    {
+        auto w = aecs::world{};
+        auto e = w.create(health{1});
+
+        auto column = aecs::dynamic_container{desc};
+        column.append(values.data(), 1);
+        w.add(column, &e, 1);
+
+        // the same name with smaller elements
+        auto small = aecs::dynamic_container{
+            std::make_shared<const aecs::component_descriptor>(
+                "script_value", 4, 4)};
+        small.push_back_default();
+
+        REQUIRE_THROWS_AS(w.add(small, &e, 1), std::invalid_argument);
+
+        // the same size with another alignment
+        auto packed = aecs::dynamic_container{
+            std::make_shared<const aecs::component_descriptor>(
+                "script_value", sizeof(script_value), 4)};
+        packed.push_back_default();
+
+        REQUIRE_THROWS_AS(w.add(packed, &e, 1), std::invalid_argument);
+
+        // an equal descriptor of its own is fine
+        auto equal = aecs::dynamic_container{
+            std::make_shared<const aecs::component_descriptor>(
+                "script_value", sizeof(script_value), alignof(script_value))};
+        equal.append(values.data() + 5, 1);
+        w.add(equal, &e, 1);
+
+        auto& arch = w.archetype(w.entities().locate(e).archetype);
+        auto& col  = static_cast<aecs::dynamic_container&>(
+            arch.column(arch.column_index(desc->hash())));
+        REQUIRE(id_at(col, w.entities().locate(e).row) == 5);
+    }
+}
\ No newline at end of file
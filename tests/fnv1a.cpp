@@ -0,0 +1,37 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "aecs/component/type.hpp"
+#include "aecs/utility/fnv1a.hpp"
+
+struct ex1
+{
+    static constexpr auto name = "example_component_name";
+};
+
+TEST_CASE("fnv1a")
+{
+    constexpr auto str = std::string_view{"hello"};
+
+    static_assert(aecs::fnv1a(str) == 0xe9c562c0fdb23244);
+    static_assert(aecs::fnv1a("") == 0xefd01f60ba992926);
+
+    constexpr auto example_hash = aecs::fnv1a("example_component_name");
+
+    static_assert(example_hash == 0x3d9b2eaac21283a3);
+
+    // names only known at runtime hash to the same value
+    auto name = std::string{"example_"};
+    name += "component_name";
+    REQUIRE(aecs::fnv1a(name) == example_hash);
+
+    constexpr auto hash = aecs::component_type<ex1>{}.hash();
+
+    static_assert(hash == aecs::name_hash("example_component_name"));
+    REQUIRE(aecs::name_hash(name) == hash);
+
+#ifndef AECS_COMPONENT_HASH_SHA1
+    static_assert(hash == example_hash);
+#endif
+}
\ No newline at end of file
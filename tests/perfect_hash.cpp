@@ -0,0 +1,104 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+#include "aecs/component/set.hpp"
+#include "aecs/utility/perfect_hash.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct health
+{
+    int value;
+};
+
+struct dead
+{};
+
+constexpr auto keys = std::array<std::uint64_t, 5>{
+    1, 2, 0xdeadbeef, 0x8000000000000000ull, 0xffffffffffffffffull};
+constexpr auto table = aecs::perfect_hash{keys};
+
+static_assert(table.find(1) == 0);
+static_assert(table.find(2) == 1);
+static_assert(table.find(0xdeadbeef) == 2);
+static_assert(table.find(0x8000000000000000ull) == 3);
+static_assert(table.find(0xffffffffffffffffull) == 4);
+static_assert(!table.contains(3));
+static_assert(!table.contains(0));
+
+static_assert(!aecs::perfect_hash{std::array<std::uint64_t, 0>{}}.contains(0));
+
+using set = aecs::component_set<position, velocity, health>;
+
+static_assert(set::index<position>() == 0);
+static_assert(set::index<velocity>() == 1);
+static_assert(set::index<health>() == 2);
+static_assert(set::index<dead>() == set::npos);
+} // namespace
+
+TEST_CASE("perfect_hash")
+{
+    SECTION("many keys")
+    {
+        // consecutive keys share most of their bits
+        constexpr auto seq = []() {
+            auto res = std::array<std::uint64_t, 64>{};
+
+            for (std::size_t i = 0; i != res.size(); ++i)
+            {
+                res[i] = i * 8;
+            }
+
+            return res;
+        }();
+        static constexpr auto seq_table = aecs::perfect_hash{seq};
+
+        for (std::size_t i = 0; i != seq.size(); ++i)
+        {
+            REQUIRE(seq_table.find(seq[i]) == i);
+            REQUIRE(!seq_table.contains(seq[i] + 1));
+        }
+    }
+
+    SECTION("duplicates")
+    {
+        const auto dup = std::array<std::uint64_t, 4>{1, 2, 0xdeadbeef, 2};
+        REQUIRE_THROWS_AS(aecs::perfect_hash{dup}, std::invalid_argument);
+    }
+
+    SECTION("component_set")
+    {
+        REQUIRE(set::contains(aecs::component_type<velocity>::hash()));
+        REQUIRE(!set::contains(aecs::component_type<dead>::hash()));
+
+        auto col = aecs::wrapped_container<velocity>{};
+        col.push_back<velocity>(velocity{1, 2});
+
+        aecs::polymorphic_container& base = col;
+
+        std::size_t visited_size = 0;
+        auto visited = set::visit(
+            base, [&](auto& wrapped) { visited_size = wrapped.get().size(); });
+
+        REQUIRE(visited);
+        REQUIRE(visited_size == 1);
+
+        auto other = aecs::wrapped_container<dead>{};
+        REQUIRE(!set::visit(static_cast<const aecs::polymorphic_container&>(
+                                other),
+                            [](const auto&) {}));
+    }
+}
\ No newline at end of file
@@ -1,11 +1,19 @@
 #define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <catch2/catch.hpp>
 
+#include "aecs/container/chunked.hpp"
 #include "aecs/container/wrapped.hpp"
 
 struct my_tag
 {};
 
+struct chunked_int
+{
+    using container_type = aecs::chunked_container<chunked_int, 64>;
+
+    int i;
+};
+
 TEST_CASE("polymorphic_container")
 {
     SECTION("polymorphic")
@@ -32,6 +40,115 @@ TEST_CASE("polymorphic_container")
         };
     }
 
+    SECTION("bulk")
+    {
+        std::unique_ptr<aecs::polymorphic_container> src =
+            std::make_unique<aecs::wrapped_container<int>>();
+        auto dst = src->replicate();
+
+        int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        src->append(values, 10);
+        REQUIRE(src->size() == 10);
+
+        const std::size_t rows[] = {1, 2, 3, 7};
+        src->move_rows_to(*dst, rows, 4);
+
+        REQUIRE(dst->get<int>() == std::vector<int>{1, 2, 3, 7});
+
+        // same result as swap_pop from the highest to the lowest index
+        auto expected = std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        for (auto it = std::rbegin(rows); it != std::rend(rows); ++it)
+        {
+            expected[*it] = expected.back();
+            expected.pop_back();
+        }
+
+        REQUIRE(src->get<int>() == expected);
+    }
+
+    SECTION("bulk_chunked")
+    {
+        auto src = aecs::wrapped_container<chunked_int>{};
+        auto dst = aecs::wrapped_container<chunked_int>{};
+
+        auto values = std::vector<chunked_int>{};
+        for (auto i = 0; i < 40; ++i)
+        {
+            values.push_back(chunked_int{i});
+        }
+
+        src.append(values.data(), values.size());
+        REQUIRE(src.size() == 40);
+        REQUIRE(src.get().block_count() == 3);
+
+        // crosses a block boundary
+        const std::size_t rows[] = {14, 15, 16, 17, 30};
+        src.move_rows_to(dst, rows, 5);
+
+        REQUIRE(dst.size() == 5);
+        REQUIRE(dst.get()[2].i == 16);
+        REQUIRE(dst.get()[4].i == 30);
+
+        REQUIRE(src.size() == 35);
+        REQUIRE(src.get()[14].i == 35);
+        REQUIRE(src.get()[17].i == 38);
+        REQUIRE(src.get()[30].i == 39);
+    }
+
+    SECTION("runs")
+    {
+        auto values = std::vector<chunked_int>{};
+        for (auto i = 0; i < 40; ++i)
+        {
+            values.push_back(chunked_int{i});
+        }
+
+        std::unique_ptr<aecs::polymorphic_container> chunked =
+            std::make_unique<aecs::wrapped_container<chunked_int>>();
+        chunked->append(values.data(), values.size());
+
+        REQUIRE(chunked->element_size() == sizeof(chunked_int));
+        REQUIRE(chunked->element_alignment() == alignof(chunked_int));
+        REQUIRE(chunked->run_count() == 3);
+
+        auto sum   = 0;
+        auto total = std::size_t{0};
+        chunked->for_each_run(
+            [&](std::size_t first, void* data, std::size_t size) {
+                REQUIRE(first == total);
+                for (std::size_t i = 0; i != size; ++i)
+                {
+                    sum += static_cast<chunked_int*>(data)[i].i;
+                }
+                total += size;
+            });
+
+        REQUIRE(total == 40);
+        REQUIRE(sum == 39 * 40 / 2);
+
+        auto ints = aecs::wrapped_container<int>{};
+        REQUIRE(ints.run_count() == 0);
+        ints.push_back<int>(5);
+        REQUIRE(ints.run_count() == 1);
+        REQUIRE(ints.run(0).size == 1);
+        REQUIRE(*static_cast<int*>(ints.run(0).data) == 5);
+
+        // the same runs through a const container
+        const auto& const_ints = ints;
+        REQUIRE(const_ints.run(0).data == ints.run(0).data);
+
+        total = 0;
+        static_cast<const aecs::polymorphic_container&>(*chunked).for_each_run(
+            [&](std::size_t, const void*, std::size_t size) { total += size; });
+        REQUIRE(total == 40);
+
+        // nothing to address
+        auto tags = aecs::wrapped_container<my_tag>{};
+        tags.push_back<my_tag>();
+        REQUIRE(tags.element_size() == 0);
+        REQUIRE(tags.run_count() == 0);
+    }
+
     SECTION("concrete")
     {
         auto ivec = std::vector<int>{};
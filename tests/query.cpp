@@ -0,0 +1,218 @@
+#include <catch2/catch.hpp>
+
+#include "aecs/world/query.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct frozen
+{};
+
+struct health
+{
+    int value;
+};
+
+struct stunned
+{};
+} // namespace
+
+TEST_CASE("query")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+
+    auto w = aecs::world{};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        w.create(position{0, 0}, velocity{1, 2});
+    }
+
+    w.create(position{0, 0}, velocity{1, 2}, frozen{});
+    w.create(position{5, 5});
+
+    auto q = aecs::query{
+        w,
+        constraint_list{
+            constraint{access::write, std::in_place_type<position>},
+            constraint{access::read, std::in_place_type<velocity>},
+            constraint{access::exclude, std::in_place_type<frozen>}}};
+
+    REQUIRE(q.archetypes().size() == 1);
+    REQUIRE(q.size() == 100);
+
+    q.for_each([](const aecs::chunk& c) {
+        auto& pos = c.get<position>();
+        auto& vel = c.get<velocity>();
+
+        for (auto i = c.begin(); i != c.end(); ++i)
+        {
+            pos[i].x += vel[i].dx;
+        }
+    });
+
+    SECTION("new archetypes")
+    {
+        const auto count = w.archetype_count();
+
+        // a new matching archetype created after the query
+        auto e = w.create(position{0, 0}, velocity{1, 2}, health{3});
+        REQUIRE(w.archetype_count() == count + 1);
+
+        REQUIRE(q.archetypes().size() == 2);
+        REQUIRE(q.size() == 101);
+
+        // moving to a non matching archetype
+        w.add<frozen>(e);
+        REQUIRE(q.archetypes().size() == 2);
+        REQUIRE(q.size() == 100);
+
+        // creating into existing archetypes doesn't touch the cache
+        w.create(position{0, 0}, velocity{1, 2});
+        REQUIRE(q.archetypes().size() == 2);
+        REQUIRE(q.size() == 101);
+    }
+
+    SECTION("unknown components")
+    {
+        const auto known = w.components().size();
+
+        // stunned is in no archetype yet and isn't registered by looking
+        const auto requires_stunned = constraint_list{
+            constraint{access::read, std::in_place_type<stunned>}};
+        const auto excludes_stunned = constraint_list{
+            constraint{access::read, std::in_place_type<position>},
+            constraint{access::exclude, std::in_place_type<stunned>}};
+
+        auto v      = aecs::view{w, requires_stunned};
+        auto q_req  = aecs::query{w, requires_stunned};
+        auto q_excl = aecs::query{w, excludes_stunned};
+
+        REQUIRE(!v.mask());
+        REQUIRE(v.chunks().empty());
+        REQUIRE(q_req.size() == 0);
+        REQUIRE(q_excl.size() == 102);
+        REQUIRE(w.components().size() == known);
+
+        // the queries pick stunned up once an archetype registers it
+        w.create(position{0, 0}, stunned{});
+
+        REQUIRE(q_req.size() == 1);
+        REQUIRE(q_excl.size() == 102);
+    }
+
+    SECTION("parallel")
+    {
+        auto pool = aecs::thread_pool{2};
+
+        q.parallel_for_each(pool, [](const aecs::chunk& c) {
+            auto& pos = c.get<position>();
+
+            for (auto i = c.begin(); i != c.end(); ++i)
+            {
+                pos[i].y += 1;
+            }
+        });
+
+        auto sum = 0.0f;
+
+        q.for_each([&](const aecs::chunk& c) {
+            auto& pos = c.get<position>();
+
+            for (auto i = c.begin(); i != c.end(); ++i)
+            {
+                sum += pos[i].x + pos[i].y;
+            }
+        });
+
+        REQUIRE(sum == 200.0f);
+    }
+}
+
+TEST_CASE("query changes")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+
+    auto w = aecs::world{};
+
+    constexpr auto rows = 3 * aecs::archetype::chunk_rows;
+    auto           last = aecs::entity::id{};
+
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        last = w.create(position{0, 0}, velocity{1, 2});
+    }
+
+    auto reader = aecs::query{
+        w,
+        constraint_list{
+            constraint{access::read, std::in_place_type<position>}}};
+    auto writer = aecs::query{
+        w,
+        constraint_list{
+            constraint{access::write, std::in_place_type<position>},
+            constraint{access::read, std::in_place_type<velocity>}}};
+
+    // everything is new
+    REQUIRE(reader.changed_chunks<position>(0).size() == 3);
+
+    auto since = w.advance_version();
+    REQUIRE(reader.changed_chunks<position>(since).empty());
+
+    SECTION("world writes")
+    {
+        w.get<position>(last).x = 1;
+
+        auto changed = reader.changed_chunks<position>(since);
+        REQUIRE(changed.size() == 1);
+        REQUIRE(changed.front().index() == 2);
+
+        // only position was written
+        REQUIRE(!changed.front().changed_since<velocity>(since));
+    }
+
+    SECTION("writer access")
+    {
+        auto visited = 0;
+
+        writer.for_each([&](const aecs::chunk&) { ++visited; });
+
+        // write access marks everything handed out, read access doesn't
+        REQUIRE(visited == 3);
+        REQUIRE(reader.changed_chunks<position>(since).size() == 3);
+        REQUIRE(reader.changed_chunks<velocity>(since).empty());
+
+        since = w.advance_version();
+        reader.for_each([](const aecs::chunk&) {});
+        REQUIRE(reader.changed_chunks<position>(since).empty());
+
+        auto skipped = 0;
+        w.get<position>(last).x = 2;
+        reader.for_each_changed<position>(
+            since, [&](const aecs::chunk& c) { skipped += c.index(); });
+        REQUIRE(skipped == 2);
+    }
+
+    SECTION("structural")
+    {
+        // the last row moves into row 0, the chunk it left only shrinks
+        w.destroy(w.archetype(1).entities()[0]);
+
+        auto changed = reader.changed_chunks<position>(since);
+        REQUIRE(changed.size() == 1);
+        REQUIRE(changed.front().index() == 0);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include <catch2/catch.hpp>
+
+#include "aecs/entity/registry.hpp"
+
+TEST_CASE("registry")
+{
+    using aecs::entity::id;
+    using aecs::entity::location;
+
+    auto reg = aecs::entity::registry{};
+
+    REQUIRE(!id{});
+    REQUIRE(!reg.alive(id{}));
+
+    auto e0 = reg.create(location{0, 0});
+    auto e1 = reg.create(location{0, 1});
+
+    REQUIRE(e0);
+    REQUIRE(e0 != e1);
+    REQUIRE(reg.size() == 2);
+    REQUIRE(reg.alive(e0));
+    REQUIRE(reg.alive(e1));
+    REQUIRE(reg.locate(e1).row == 1);
+
+    reg.locate(e1).row = 0;
+    REQUIRE(reg.locate(e1).row == 0);
+
+    reg.destroy(e0);
+    REQUIRE(!reg.alive(e0));
+    REQUIRE(reg.size() == 1);
+
+    // the slot is recycled with a new generation
+    auto e2 = reg.create(location{1, 0});
+    REQUIRE(e2.index() == e0.index());
+    REQUIRE(e2.generation() == e0.generation() + 1);
+    REQUIRE(reg.alive(e2));
+    REQUIRE(!reg.alive(e0));
+    REQUIRE(reg.capacity() == 2);
+
+    reg.destroy(e1);
+    reg.destroy(e2);
+    REQUIRE(reg.size() == 0);
+
+    // most recently released slot first
+    auto e3 = reg.create(location{0, 0});
+    REQUIRE(e3.index() == e2.index());
+    auto e4 = reg.create(location{0, 0});
+    REQUIRE(e4.index() == e1.index());
+    REQUIRE(reg.capacity() == 2);
+}
\ No newline at end of file
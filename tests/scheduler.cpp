@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+
+#include "aecs/system/scheduler.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct health
+{
+    int value;
+};
+
+struct dead
+{};
+} // namespace
+
+TEST_CASE("scheduler")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+
+    auto w = aecs::world{};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        w.create(position{0, 0}, velocity{1, 1}, health{10});
+    }
+
+    auto sched = aecs::scheduler{};
+
+    static std::atomic<int> step{0};
+    static int              move_step   = -1;
+    static int              damage_step = -1;
+    static int              render_step = -1;
+    step = 0;
+
+    // 0: write position, read velocity
+    auto move = sched.add_system(
+        constraint_list{constraint{access::write, std::in_place_type<position>},
+                        constraint{access::read, std::in_place_type<velocity>}},
+        [](aecs::world&) { move_step = step++; });
+
+    // 1: only health, overlaps with move
+    auto damage = sched.add_system(
+        constraint_list{constraint{access::write, std::in_place_type<health>},
+                        constraint{access::exclude, std::in_place_type<dead>}},
+        [](aecs::world&) { damage_step = step++; });
+
+    // 2: reads position and health, waits for both
+    auto render = sched.add_system(
+        constraint_list{constraint{access::read, std::in_place_type<position>},
+                        constraint{access::read, std::in_place_type<health>}},
+        [](aecs::world&) { render_step = step++; });
+
+    REQUIRE(sched.size() == 3);
+    REQUIRE(!sched.depends_on(damage, move));
+    REQUIRE(sched.depends_on(render, move));
+    REQUIRE(sched.depends_on(render, damage));
+    REQUIRE(!sched.depends_on(move, render));
+
+    SECTION("serial")
+    {
+        sched.run(w);
+
+        REQUIRE(move_step == 0);
+        REQUIRE(damage_step == 1);
+        REQUIRE(render_step == 2);
+
+        // dead is in no archetype, run registered it for the views
+        const auto hash = aecs::component_type<dead>::hash();
+        REQUIRE(w.components().find(hash) !=
+                aecs::component_registry::invalid_index);
+
+        // the same for every other world it runs on
+        auto other = aecs::world{};
+        sched.run(other);
+        REQUIRE(other.components().find(hash) !=
+                aecs::component_registry::invalid_index);
+    }
+
+    SECTION("parallel")
+    {
+        auto pool = aecs::thread_pool{3};
+
+        for (auto frame = 0; frame < 50; ++frame)
+        {
+            step = 0;
+            sched.run(w, pool);
+
+            REQUIRE(step == 3);
+            REQUIRE(render_step == 2);
+        }
+    }
+
+    SECTION("nested_parallelism")
+    {
+        auto pool = aecs::thread_pool{2};
+
+        static aecs::thread_pool* pool_ptr = nullptr;
+        pool_ptr                          = &pool;
+
+        sched.add_system(
+            constraint_list{
+                constraint{access::write, std::in_place_type<velocity>}},
+            [](aecs::world&) {
+                auto count = std::atomic<int>{0};
+                pool_ptr->parallel_for(
+                    16, [&](std::size_t) { count.fetch_add(1); });
+                REQUIRE(count.load() == 16);
+            });
+
+        sched.run(w, pool);
+        REQUIRE(step == 3);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "aecs/container/bit_tag.hpp"
+#include "aecs/container/chunked.hpp"
+#include "aecs/container/soa.hpp"
+#include "aecs/world/snapshot.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+
+    using container_type = aecs::soa_container<velocity>;
+};
+
+struct health
+{
+    int value;
+
+    using container_type = aecs::chunked_container<health>;
+};
+
+struct is_active
+{
+    using container_type = aecs::bit_tag_container<is_active>;
+};
+
+struct frozen
+{};
+} // namespace
+
+TEST_CASE("snapshot")
+{
+    const auto path = std::string{"aecs_snapshot_test.bin"};
+
+    auto w   = aecs::world{};
+    auto ids = std::vector<aecs::entity::id>{};
+
+    for (auto i = 0; i < 5000; ++i)
+    {
+        ids.push_back(w.create(position{float(i), 0},
+                               velocity{1, float(i)},
+                               health{i},
+                               is_active{}));
+    }
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        w.create(position{float(i), 1}, frozen{});
+    }
+
+    const auto empty = w.create();
+
+    // leaves released slots and disabled bits behind
+    for (std::size_t i = 0; i < ids.size(); i += 7)
+    {
+        w.get<is_active>(ids[i]) = false;
+    }
+
+    for (std::size_t i = 1; i < ids.size(); i += 10)
+    {
+        w.destroy(ids[i]);
+    }
+
+    w.advance_version();
+    REQUIRE(aecs::write_snapshot(w, path.c_str()));
+
+    SECTION("load")
+    {
+        auto loaded = aecs::world{};
+        REQUIRE(aecs::load_snapshot<position,
+                                    velocity,
+                                    health,
+                                    is_active,
+                                    frozen>(loaded, path.c_str()));
+
+        REQUIRE(loaded.size() == w.size());
+        REQUIRE(loaded.archetype_count() == w.archetype_count());
+        REQUIRE(loaded.version() == w.version());
+        REQUIRE(loaded.alive(empty));
+
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            REQUIRE(loaded.alive(ids[i]) == w.alive(ids[i]));
+
+            if (!w.alive(ids[i]))
+            {
+                continue;
+            }
+
+            REQUIRE(loaded.get<position>(ids[i]).x ==
+                    w.get<position>(ids[i]).x);
+            REQUIRE(static_cast<velocity>(loaded.get<velocity>(ids[i])).dy ==
+                    static_cast<velocity>(w.get<velocity>(ids[i])).dy);
+            REQUIRE(loaded.get<health>(ids[i]).value ==
+                    w.get<health>(ids[i]).value);
+            REQUIRE(static_cast<bool>(loaded.get<is_active>(ids[i])) ==
+                    static_cast<bool>(w.get<is_active>(ids[i])));
+        }
+
+        // released slots are reused in the same order
+        REQUIRE(loaded.create(position{}) == w.create(position{}));
+    }
+
+    SECTION("unknown component")
+    {
+        auto loaded = aecs::world{};
+        REQUIRE(!aecs::load_snapshot<position, velocity, health, is_active>(
+            loaded, path.c_str()));
+        REQUIRE(loaded.size() == 0);
+    }
+
+    SECTION("malformed")
+    {
+        auto bytes = std::string{};
+
+        {
+            auto in = std::ifstream{path, std::ios::binary};
+            bytes.assign(std::istreambuf_iterator<char>{in}, {});
+        }
+
+        auto load = [&](const std::string& content) {
+            std::ofstream{path, std::ios::binary | std::ios::trunc} << content;
+            auto loaded = aecs::world{};
+            return aecs::load_snapshot<position,
+                                       velocity,
+                                       health,
+                                       is_active,
+                                       frozen>(loaded, path.c_str());
+        };
+
+        REQUIRE(load(bytes));
+        REQUIRE(!load(bytes.substr(0, bytes.size() - 1)));
+        REQUIRE(!load(bytes.substr(0, 16)));
+        REQUIRE(!load(std::string{}));
+
+        bytes[0] = 'X';
+        REQUIRE(!load(bytes));
+    }
+
+    SECTION("free list")
+    {
+        using header = aecs::detail::snapshot::header;
+        using slot   = aecs::entity::registry::slot;
+
+        auto bytes = std::string{};
+
+        {
+            auto in = std::ifstream{path, std::ios::binary};
+            bytes.assign(std::istreambuf_iterator<char>{in}, {});
+        }
+
+        auto read_u32 = [&](std::size_t offset) {
+            auto res = std::uint32_t{};
+            std::memcpy(&res, bytes.data() + offset, sizeof(res));
+            return res;
+        };
+
+        // the changed bytes are restored when load returns
+        auto load_with = [&](std::size_t offset, std::uint32_t value) {
+            const auto original = bytes;
+            std::memcpy(&bytes[offset], &value, sizeof(value));
+            std::ofstream{path, std::ios::binary | std::ios::trunc} << bytes;
+            bytes = original;
+
+            auto loaded = aecs::world{};
+            return aecs::load_snapshot<position,
+                                       velocity,
+                                       health,
+                                       is_active,
+                                       frozen>(loaded, path.c_str());
+        };
+
+        const auto head_offset = offsetof(header, free_head);
+        const auto free_head   = read_u32(head_offset);
+        const auto next_offset = sizeof(header) + free_head * sizeof(slot) +
+                                 offsetof(slot, location) +
+                                 offsetof(aecs::entity::location, row);
+        const auto next = read_u32(next_offset);
+        const auto dead = aecs::entity::registry::dead;
+
+        REQUIRE(free_head != dead);
+        REQUIRE(next != dead);
+
+        REQUIRE(load_with(head_offset, free_head));
+        // past the slots
+        const auto slot_count = std::uint32_t(w.entities().capacity());
+        REQUIRE(!load_with(head_offset, slot_count));
+        // an alive slot
+        REQUIRE(!load_with(head_offset, ids[0].index()));
+        // a cycle
+        REQUIRE(!load_with(next_offset, free_head));
+        // dead slots which aren't linked
+        REQUIRE(!load_with(next_offset, dead));
+        REQUIRE(!load_with(head_offset, next));
+    }
+
+    REQUIRE(!aecs::load_snapshot<position>(w, "aecs_no_such_snapshot.bin"));
+    std::remove(path.c_str());
+}
\ No newline at end of file
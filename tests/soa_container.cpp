@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+
+#include <array>
+
+#include "aecs/container/soa.hpp"
+#include "aecs/container/wrapped.hpp"
+#include "aecs/world/world.hpp"
+
+namespace
+{
+struct vec3
+{
+    float x, y, z;
+};
+
+struct particle
+{
+    using container_type = aecs::soa_container<particle>;
+
+    float x, y, z;
+    int   lifetime;
+};
+
+// C arrays are counted per element, see aggregate_arity_v
+struct c_array_member
+{
+    float v[3];
+    int   id;
+};
+
+struct std_array_member
+{
+    std::array<float, 3> v;
+    int                  id;
+};
+
+struct flagged
+{
+    float x;
+    bool  alive;
+};
+} // namespace
+
+TEST_CASE("soa_container")
+{
+    static_assert(aecs::aggregate_arity_v<vec3> == 3);
+    static_assert(aecs::aggregate_arity_v<particle> == 4);
+    static_assert(std::is_same_v<aecs::aggregate_member_t<3, particle>, int>);
+    static_assert(aecs::aggregate_arity_v<c_array_member> == 4);
+    static_assert(aecs::aggregate_arity_v<std_array_member> == 2);
+    static_assert(std::is_same_v<aecs::aggregate_member_t<0, std_array_member>,
+                                 std::array<float, 3>>);
+
+    auto cont = aecs::soa_container<vec3>{};
+
+    REQUIRE(cont.empty());
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        auto f = static_cast<float>(i);
+        cont.push_back(vec3{f, f * 2, f * 3});
+    }
+
+    REQUIRE(cont.size() == 10);
+    REQUIRE(cont.member<0>().size() == 10);
+
+    // member arrays are contiguous
+    REQUIRE(&cont.member<1>()[1] == &cont.member<1>()[0] + 1);
+
+    vec3 v = cont[4];
+    REQUIRE(v.x == 4);
+    REQUIRE(v.y == 8);
+    REQUIRE(v.z == 12);
+
+    cont[4] = vec3{1, 1, 1};
+    REQUIRE(cont.member<2>()[4] == 1);
+    REQUIRE(cont[4].get<0>() == 1);
+
+    // proxy assignment assigns the value
+    cont[0] = cont[9];
+    REQUIRE(cont.member<0>()[0] == 9);
+    REQUIRE(cont.member<0>()[9] == 9);
+
+    cont.swap_pop(1);
+    REQUIRE(cont.size() == 9);
+    REQUIRE(static_cast<vec3>(cont[1]).y == 18);
+
+    auto sum = 0.0f;
+    for (auto& x : cont.member<0>())
+    {
+        x += 1;
+    }
+    for (vec3 e : cont)
+    {
+        sum += e.x;
+    }
+    REQUIRE(sum == 10 + 10 + 3 + 4 + 2 + 6 + 7 + 8 + 9);
+
+    SECTION("make_container")
+    {
+        static_assert(std::is_same_v<aecs::soa_container<particle>,
+                                     aecs::component_container_t<particle>>);
+
+        auto w  = aecs::world{};
+        auto e0 = w.create(particle{1, 2, 3, 10});
+        auto e1 = w.create(particle{4, 5, 6, 20});
+
+        w.destroy(e0);
+
+        particle p = w.get<particle>(e1);
+        REQUIRE(p.lifetime == 20);
+
+        w.get<particle>(e1) = particle{0, 0, 0, 30};
+        REQUIRE(w.get<particle>(e1).get<3>() == 30);
+
+        auto& arch = w.archetype(w.entities().locate(e1).archetype);
+        REQUIRE(arch.get<particle>().member<3>()[0] == 30);
+    }
+
+    SECTION("bool")
+    {
+        static_assert(std::is_same_v<
+                      aecs::soa_container<flagged>::member_storage_type<1>,
+                      aecs::soa_bool>);
+
+        auto flags = aecs::soa_container<flagged>{};
+        flags.push_back(flagged{1, true});
+        flags.push_back(flagged{2, false});
+
+        bool& alive = flags[1].get<1>();
+        alive       = true;
+        REQUIRE(flags.member<1>()[1].value);
+
+        flags[0] = flagged{3, false};
+        flags.swap_pop(1);
+
+        flagged f = flags.back();
+        REQUIRE(f.x == 3);
+        REQUIRE(!f.alive);
+        REQUIRE(flags.size() == 1);
+    }
+}
\ No newline at end of file
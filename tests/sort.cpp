@@ -0,0 +1,196 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "aecs/world/sort.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct health
+{
+    int value;
+};
+
+// interleave the bits of the lower 16 bits of x and y
+std::uint64_t morton(const position& p)
+{
+    auto spread = [](std::uint32_t v) {
+        v &= 0xffff;
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return std::uint64_t{v};
+    };
+
+    return spread(static_cast<std::uint32_t>(p.x)) |
+           (spread(static_cast<std::uint32_t>(p.y)) << 1);
+}
+
+// the order std::stable_sort produces
+std::vector<std::size_t> expected_order(const std::vector<std::uint64_t>& keys)
+{
+    auto res = std::vector<std::size_t>(keys.size());
+
+    for (std::size_t i = 0; i != res.size(); ++i)
+    {
+        res[i] = i;
+    }
+
+    std::stable_sort(res.begin(), res.end(), [&](auto lhs, auto rhs) {
+        return keys[lhs] < keys[rhs];
+    });
+    return res;
+}
+} // namespace
+
+TEST_CASE("sort_order")
+{
+    auto rng   = std::mt19937_64{42};
+    auto keys  = std::vector<std::uint64_t>(100000);
+    auto order = std::vector<std::size_t>{};
+    auto pool  = aecs::thread_pool{2};
+
+    SECTION("full")
+    {
+        // few distinct keys to test stability, and a wide one
+        for (auto& k : keys)
+        {
+            k = rng() % 1000;
+        }
+
+        keys[7] = ~std::uint64_t{0};
+
+        aecs::sort_order(keys.data(), keys.size(), order);
+        REQUIRE(order == expected_order(keys));
+
+        aecs::sort_order(pool, keys.data(), keys.size(), order);
+        REQUIRE(order == expected_order(keys));
+    }
+
+    SECTION("incremental")
+    {
+        for (std::size_t i = 0; i != keys.size(); ++i)
+        {
+            keys[i] = i / 4;
+        }
+
+        // already sorted
+        aecs::sort_order(
+            keys.data(), keys.size(), order, aecs::sort_mode::incremental);
+        REQUIRE(order == expected_order(keys));
+
+        // a few moved
+        for (auto i = 0; i != 100; ++i)
+        {
+            keys[rng() % keys.size()] = rng() % keys.size();
+        }
+
+        aecs::sort_order(
+            keys.data(), keys.size(), order, aecs::sort_mode::incremental);
+        REQUIRE(order == expected_order(keys));
+
+        // too many for incremental, falls back to a full sort
+        std::shuffle(keys.begin(), keys.end(), rng);
+        aecs::sort_order(pool,
+                         keys.data(),
+                         keys.size(),
+                         order,
+                         aecs::sort_mode::incremental);
+        REQUIRE(order == expected_order(keys));
+    }
+}
+
+TEST_CASE("sort_rows")
+{
+    auto w   = aecs::world{};
+    auto rng = std::mt19937{7};
+    auto ids = std::vector<aecs::entity::id>{};
+
+    for (auto i = 0; i != 10000; ++i)
+    {
+        const auto p = position{float(rng() % 256), float(rng() % 256)};
+
+        if (i % 3 == 0)
+        {
+            ids.push_back(w.create(p));
+        }
+        else
+        {
+            ids.push_back(w.create(p, health{i}));
+        }
+    }
+
+    // remembers what belongs to which entity
+    auto positions = std::vector<position>{};
+    for (auto e : ids)
+    {
+        positions.push_back(w.get<position>(e));
+    }
+
+    auto check = [&]() {
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            REQUIRE(w.get<position>(ids[i]).x == positions[i].x);
+            REQUIRE(w.get<position>(ids[i]).y == positions[i].y);
+
+            if (i % 3 != 0)
+            {
+                REQUIRE(w.get<health>(ids[i]).value == static_cast<int>(i));
+            }
+        }
+
+        for (std::size_t a = 0; a != w.archetype_count(); ++a)
+        {
+            const auto& arch = w.archetype(a);
+
+            if (arch.template has_component<position>())
+            {
+                const auto& col = arch.template get<position>();
+                REQUIRE(std::is_sorted(
+                    col.begin(), col.end(), [](auto lhs, auto rhs) {
+                        return morton(lhs) < morton(rhs);
+                    }));
+            }
+        }
+    };
+
+    SECTION("serial")
+    {
+        const auto before = w.advance_version();
+        aecs::sort_rows<position>(w, morton);
+        check();
+
+        // sorted rows are marked changed
+        const auto loc = w.entities().locate(ids[1]);
+        REQUIRE(w.archetype(loc.archetype).changed_since(0, 0, before));
+
+        const auto since = w.advance_version();
+        REQUIRE(!w.archetype(loc.archetype).changed_since(0, 0, since));
+
+        // nothing to do, nothing marked
+        aecs::sort_rows<position>(w, morton, aecs::sort_mode::incremental);
+        REQUIRE(!w.archetype(loc.archetype).changed_since(0, 0, since));
+
+        w.get<position>(ids[1]) = position{0, 0};
+        positions[1]            = position{0, 0};
+        aecs::sort_rows<position>(w, morton, aecs::sort_mode::incremental);
+        REQUIRE(w.entities().locate(ids[1]).row == 0);
+        check();
+    }
+
+    SECTION("parallel")
+    {
+        auto pool = aecs::thread_pool{2};
+        aecs::sort_rows<position>(w, pool, morton);
+        check();
+    }
+}
\ No newline at end of file
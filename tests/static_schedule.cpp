@@ -0,0 +1,186 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+
+#include "aecs/system/static_schedule.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct health
+{
+    int value;
+};
+
+struct dead
+{};
+
+using aecs::entity::access;
+using aecs::entity::static_constraint;
+
+// 0: write position, read velocity
+using move_system =
+    aecs::system_access<static_constraint<access::write, position>,
+                        static_constraint<access::read, velocity>>;
+
+// 1: only health, overlaps with move
+using damage_system =
+    aecs::system_access<static_constraint<access::write, health>,
+                        static_constraint<access::exclude, dead>>;
+
+// 2: reads position and health, waits for both
+using render_system =
+    aecs::system_access<static_constraint<access::read, position>,
+                        static_constraint<access::read, health>>;
+
+// 3: reads velocity only, overlaps with everything
+using debug_system =
+    aecs::system_access<static_constraint<access::read, velocity>>;
+
+using plan =
+    aecs::static_plan<move_system, damage_system, render_system, debug_system>;
+
+static_assert(plan::size == 4);
+
+static_assert(!plan::conflicts[0][1] && !plan::conflicts[1][0]);
+static_assert(plan::conflicts[0][2] && plan::conflicts[2][0]);
+static_assert(plan::conflicts[1][2]);
+static_assert(!plan::conflicts[0][3] && !plan::conflicts[2][3]);
+static_assert(!plan::conflicts[0][0]);
+
+static_assert(plan::stages[0] == 0);
+static_assert(plan::stages[1] == 0);
+static_assert(plan::stages[2] == 1);
+static_assert(plan::stages[3] == 0);
+static_assert(plan::stage_count == 2);
+
+static_assert(plan::order[0] == 0);
+static_assert(plan::order[1] == 1);
+static_assert(plan::order[2] == 3);
+static_assert(plan::order[3] == 2);
+static_assert(plan::stage_offsets[0] == 0);
+static_assert(plan::stage_offsets[1] == 3);
+static_assert(plan::stage_offsets[2] == 4);
+
+// a chain of writers to the same component, one stage each
+using chain_plan = aecs::static_plan<
+    aecs::system_access<static_constraint<access::write, health>>,
+    aecs::system_access<static_constraint<access::write, health>>,
+    aecs::system_access<static_constraint<access::read, health>>>;
+
+static_assert(chain_plan::stage_count == 3);
+static_assert(chain_plan::stages[2] == 2);
+
+static_assert(aecs::static_plan<>::stage_count == 0);
+} // namespace
+
+TEST_CASE("static_schedule")
+{
+    auto w = aecs::world{};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        w.create(position{0, 0}, velocity{1, 1}, health{10});
+    }
+
+    static std::atomic<int> step{0};
+    static int              move_step   = -1;
+    static int              damage_step = -1;
+    static int              render_step = -1;
+    static int              debug_step  = -1;
+
+    auto sched = aecs::make_static_schedule<move_system,
+                                            damage_system,
+                                            render_system,
+                                            debug_system>(
+        [](aecs::world&) { move_step = step++; },
+        [](aecs::world&) { damage_step = step++; },
+        [](aecs::world&) { render_step = step++; },
+        [](aecs::world&) { debug_step = step++; });
+
+    REQUIRE(sched.size() == 4);
+
+    SECTION("serial")
+    {
+        step = 0;
+        sched.run(w);
+
+        REQUIRE(move_step == 0);
+        REQUIRE(damage_step == 1);
+        REQUIRE(debug_step == 2);
+        REQUIRE(render_step == 3);
+
+        // dead is in no archetype, run registered it for the views, with
+        // every world it runs on
+        const auto hash = aecs::component_type<dead>::hash();
+        REQUIRE(w.components().find(hash) !=
+                aecs::component_registry::invalid_index);
+
+        auto other = aecs::world{};
+        sched.run(other);
+        REQUIRE(other.components().find(hash) !=
+                aecs::component_registry::invalid_index);
+    }
+
+    SECTION("parallel")
+    {
+        auto pool = aecs::thread_pool{3};
+
+        for (auto i = 0; i < 20; ++i)
+        {
+            step = 0;
+            sched.run(w, pool);
+
+            REQUIRE(step == 4);
+            REQUIRE(render_step == 3);
+        }
+    }
+
+    SECTION("writes")
+    {
+        auto pool  = aecs::thread_pool{2};
+        auto total = 0;
+
+        auto s = aecs::make_static_schedule<move_system, render_system>(
+            [](aecs::world& wld) {
+                for (std::size_t i = 0; i != wld.archetype_count(); ++i)
+                {
+                    auto& arch = wld.archetype(i);
+
+                    if (arch.has_component<position>())
+                    {
+                        for (auto& p : arch.get<position>())
+                        {
+                            p.x += 1;
+                        }
+                    }
+                }
+            },
+            [&total](aecs::world& wld) {
+                for (std::size_t i = 0; i != wld.archetype_count(); ++i)
+                {
+                    auto& arch = wld.archetype(i);
+
+                    if (arch.has_component<position>())
+                    {
+                        for (const auto& p : arch.get<position>())
+                        {
+                            total += static_cast<int>(p.x);
+                        }
+                    }
+                }
+            });
+
+        s.run(w, pool);
+        REQUIRE(total == 100);
+    }
+}
\ No newline at end of file
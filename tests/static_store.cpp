@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "aecs/container/chunked.hpp"
+#include "aecs/container/static_store.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct health
+{
+    using container_type = aecs::chunked_container<health, 64>;
+
+    int value;
+};
+
+struct frozen
+{};
+} // namespace
+
+TEST_CASE("static_store")
+{
+    using store_type = aecs::static_store<position, health, frozen>;
+
+    auto store = store_type{};
+
+    static_assert(store_type::column_count() == 3);
+    static_assert(store_type::column_index(
+                      aecs::component_type<health>::hash()) == 1);
+    static_assert(store_type::column_index(
+                      aecs::component_type<int>::hash()) == 3);
+    static_assert(store_type::has_component<frozen>());
+    static_assert(!store_type::has_component<int>());
+
+    for (auto i = 0; i != 40; ++i)
+    {
+        REQUIRE(store.push_back(health{i}, frozen{}, position{float(i), 0}) ==
+                static_cast<std::size_t>(i));
+    }
+
+    REQUIRE(store.size() == 40);
+    REQUIRE(store.get<health>()[17].value == 17);
+
+    SECTION("polymorphic")
+    {
+        auto& col = store.column(1);
+
+        REQUIRE(&col == &store.column<health>());
+        REQUIRE(col.size() == 40);
+        REQUIRE(col.component_hash() == store_type::component_hash(1));
+        REQUIRE(store.column(2).has_component<frozen>());
+    }
+
+    SECTION("rows")
+    {
+        auto dst = store_type{};
+
+        store.swap_pop(0);
+        REQUIRE(store.get<health>()[0].value == 39);
+        REQUIRE(store.get<position>()[0].x == 39);
+
+        // crosses a block of the chunked column
+        const std::size_t rows[] = {14, 15, 16, 17, 30};
+        REQUIRE(store.move_rows_to(dst, rows, 5) == 0);
+
+        REQUIRE(dst.size() == 5);
+        REQUIRE(dst.get<health>()[2].value == 16);
+        REQUIRE(dst.get<position>()[4].x == 30);
+        REQUIRE(dst.get<frozen>().size() == 5);
+
+        REQUIRE(store.size() == 34);
+        REQUIRE(store.get<frozen>().size() == 34);
+
+        for (std::size_t i = 0; i != store.size(); ++i)
+        {
+            REQUIRE(store.get<health>()[i].value ==
+                    static_cast<int>(store.get<position>()[i].x));
+        }
+
+        const auto values = std::vector<position>(3, position{1, 2});
+        const auto healths = std::vector<health>(3, health{7});
+        const auto tags    = std::vector<frozen>(3);
+
+        dst.append(3, values.data(), healths.data(), tags.data());
+        REQUIRE(dst.size() == 8);
+        REQUIRE(dst.get<health>()[7].value == 7);
+
+        REQUIRE(store.move_row(0, dst) == 8);
+        REQUIRE(dst.get<health>()[8].value == 39);
+        REQUIRE(store.size() == 33);
+        REQUIRE(store.get<health>()[0].value ==
+                static_cast<int>(store.get<position>()[0].x));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include "aecs/utility/thread_pool.hpp"
+
+TEST_CASE("thread_pool")
+{
+    auto pool = aecs::thread_pool{3};
+
+    REQUIRE(pool.size() == 3);
+    REQUIRE(aecs::thread_pool::current_index() ==
+            aecs::thread_pool::external_index);
+
+    SECTION("parallel_for")
+    {
+        auto hits = std::vector<int>(1000, 0);
+
+        pool.parallel_for(hits.size(), [&](std::size_t i) { hits[i] += 1; });
+
+        for (auto h : hits)
+        {
+            REQUIRE(h == 1);
+        }
+
+        // nothing to do
+        pool.parallel_for(0, [&](std::size_t) { hits[0] = 5; });
+        REQUIRE(hits[0] == 1);
+    }
+
+    SECTION("nested")
+    {
+        auto sum = std::atomic<int>{0};
+
+        pool.parallel_for(8, [&](std::size_t) {
+            pool.parallel_for(8, [&](std::size_t) { sum.fetch_add(1); });
+        });
+
+        REQUIRE(sum.load() == 64);
+    }
+
+    SECTION("submit")
+    {
+        auto done = std::atomic<int>{0};
+
+        for (auto i = 0; i < 10; ++i)
+        {
+            pool.submit([&done]() { done.fetch_add(1); });
+        }
+
+        while (done.load() != 10)
+        {
+            pool.run_one();
+        }
+
+        REQUIRE(done.load() == 10);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef AECS_ENABLE_TRACING
+#define AECS_ENABLE_TRACING
+#endif
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+
+#include "aecs/system/scheduler.hpp"
+#include "aecs/utility/trace.hpp"
+#include "aecs/world/command_buffer.hpp"
+#include "aecs/world/query.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+} // namespace
+
+TEST_CASE("trace")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+
+    static_assert(aecs::trace::enabled());
+
+    aecs::trace::clear();
+    REQUIRE(aecs::trace::size() == 0);
+
+    auto w = aecs::world{};
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        w.create(position{0, 0}, velocity{1, 1});
+    }
+
+    SECTION("scope")
+    {
+        {
+            AECS_TRACE_SCOPE("outer");
+            AECS_TRACE_SCOPE("inner", 3);
+        }
+
+        REQUIRE(aecs::trace::size() == 2);
+
+        auto os = std::ostringstream{};
+        aecs::trace::write_chrome_json(os);
+        const auto json = os.str();
+
+        REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+        REQUIRE(json.find("\"name\":\"outer\"") != std::string::npos);
+        REQUIRE(json.find("\"args\":{\"id\":3}") != std::string::npos);
+        REQUIRE(json.find("\"ph\":\"X\"") != std::string::npos);
+
+        aecs::trace::clear();
+        REQUIRE(aecs::trace::size() == 0);
+    }
+
+    SECTION("systems")
+    {
+        auto sched = aecs::scheduler{};
+        sched.add_system(
+            constraint_list{constraint{access::write,
+                                       std::in_place_type<position>}},
+            [](aecs::world&) {});
+        sched.add_system(
+            constraint_list{constraint{access::read,
+                                       std::in_place_type<position>}},
+            [](aecs::world&) {});
+
+        auto pool = aecs::thread_pool{2};
+        sched.run(w);
+        sched.run(w, pool);
+
+        // 2 systems per run, recorded on whichever thread ran them
+        REQUIRE(aecs::trace::size() == 4);
+
+        auto os = std::ostringstream{};
+        aecs::trace::write_chrome_json(os);
+        REQUIRE(os.str().find("\"name\":\"system\"") != std::string::npos);
+    }
+
+    SECTION("chunk jobs")
+    {
+        auto q = aecs::query{
+            w,
+            constraint_list{constraint{access::write,
+                                       std::in_place_type<position>}}};
+        auto pool = aecs::thread_pool{2};
+
+        q.parallel_for_each(pool, [](const auto&) {});
+        REQUIRE(aecs::trace::size() == q.chunks().size());
+    }
+
+    SECTION("flush")
+    {
+        auto cb = aecs::command_buffer{};
+        cb.spawn(position{1, 1});
+        cb.flush(w);
+
+        // the flush itself and its 5 phases
+        REQUIRE(aecs::trace::size() == 6);
+
+        auto os = std::ostringstream{};
+        aecs::trace::write_chrome_json(os);
+        REQUIRE(os.str().find("\"name\":\"flush spawns\"") !=
+                std::string::npos);
+    }
+}
\ No newline at end of file
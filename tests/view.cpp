@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+
+#include "aecs/container/aligned.hpp"
+#include "aecs/world/view.hpp"
+
+namespace
+{
+struct position
+{
+    using container_type = aecs::aligned_container<position>;
+
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct frozen
+{};
+} // namespace
+
+TEST_CASE("view")
+{
+    using aecs::entity::access;
+    using aecs::entity::constraint;
+    using aecs::entity::constraint_list;
+
+    auto w = aecs::world{};
+
+    constexpr auto moving_count = 10000;
+
+    for (auto i = 0; i < moving_count; ++i)
+    {
+        w.create(position{0, 0}, velocity{1, 2});
+    }
+
+    auto f = w.create(position{0, 0}, velocity{1, 2}, frozen{});
+    auto s = w.create(position{5, 5});
+
+    auto cs = constraint_list{
+        constraint{access::write, std::in_place_type<position>},
+        constraint{access::read, std::in_place_type<velocity>},
+        constraint{access::exclude, std::in_place_type<frozen>}};
+
+    auto v = aecs::view{w, cs};
+
+    auto chunks = v.chunks();
+    REQUIRE(chunks.size() == 3);
+
+    auto rows = std::size_t{0};
+    for (const auto& c : chunks)
+    {
+        REQUIRE(c.size() <= aecs::archetype::chunk_rows);
+        REQUIRE(c.begin() % aecs::archetype::chunk_rows == 0);
+        rows += c.size();
+    }
+    REQUIRE(rows == moving_count);
+
+    auto update = [](const aecs::chunk& c) {
+        auto&       pos = c.get<position>();
+        const auto& vel = c.get<velocity>();
+
+        for (auto i = c.begin(); i != c.end(); ++i)
+        {
+            pos[i].x += vel[i].dx;
+            pos[i].y += vel[i].dy;
+        }
+    };
+
+    SECTION("for_each")
+    {
+        v.for_each(update);
+    }
+
+    SECTION("parallel_for_each")
+    {
+        auto pool = aecs::thread_pool{3};
+        v.parallel_for_each(pool, update);
+    }
+
+    auto first = w.archetype(w.entities().locate(s).archetype).entities()[0];
+    REQUIRE(first == s);
+    REQUIRE(w.get<position>(s).x == 5);
+    REQUIRE(w.get<position>(f).x == 0);
+
+    auto sum = 0.0f;
+    v.for_each([&](const aecs::chunk& c) {
+        for (auto i = c.begin(); i != c.end(); ++i)
+        {
+            sum += c.get<position>()[i].y;
+            REQUIRE(w.alive(c.entity(i)));
+        }
+    });
+    REQUIRE(sum == 2 * moving_count);
+}
\ No newline at end of file
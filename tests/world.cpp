@@ -0,0 +1,87 @@
+#include <catch2/catch.hpp>
+
+#include "aecs/world/world.hpp"
+
+namespace
+{
+struct position
+{
+    float x, y;
+};
+
+struct velocity
+{
+    float dx, dy;
+};
+
+struct frozen
+{};
+} // namespace
+
+TEST_CASE("world")
+{
+    auto w = aecs::world{};
+
+    REQUIRE(w.size() == 0);
+    REQUIRE(w.archetype_count() == 1);
+
+    auto e0 = w.create(position{0, 0}, velocity{1, 1});
+    auto e1 = w.create(velocity{2, 2}, position{1, 1});
+    auto e2 = w.create(position{2, 2});
+
+    REQUIRE(w.size() == 3);
+    REQUIRE(w.archetype_count() == 3);
+    REQUIRE(w.alive(e0));
+    REQUIRE(w.has<velocity>(e1));
+    REQUIRE(!w.has<velocity>(e2));
+    REQUIRE(w.get<position>(e1).x == 1);
+    REQUIRE(w.get<velocity>(e1).dx == 2);
+
+    SECTION("destroy")
+    {
+        w.destroy(e0);
+
+        REQUIRE(!w.alive(e0));
+        REQUIRE(w.size() == 2);
+
+        // e1 got moved into the row of e0 and is still found
+        REQUIRE(w.get<position>(e1).x == 1);
+        REQUIRE(w.get<velocity>(e1).dx == 2);
+
+        auto e3 = w.create(position{3, 3}, velocity{3, 3});
+        REQUIRE(e3.index() == e0.index());
+        REQUIRE(!w.alive(e0));
+        REQUIRE(w.get<position>(e3).x == 3);
+    }
+
+    SECTION("add_remove")
+    {
+        w.add<frozen>(e0);
+
+        REQUIRE(w.has<frozen>(e0));
+        REQUIRE(w.archetype_count() == 4);
+        REQUIRE(w.get<position>(e0).x == 0);
+        REQUIRE(w.get<velocity>(e0).dx == 1);
+        REQUIRE(w.get<position>(e1).x == 1);
+
+        w.add<velocity>(e2, velocity{5, 5});
+        REQUIRE(w.get<velocity>(e2).dx == 5);
+        REQUIRE(w.get<position>(e2).x == 2);
+
+        // overwrites
+        w.add<velocity>(e2, velocity{6, 6});
+        REQUIRE(w.get<velocity>(e2).dx == 6);
+
+        w.remove<frozen>(e0);
+        REQUIRE(!w.has<frozen>(e0));
+        REQUIRE(w.get<velocity>(e0).dx == 1);
+
+        w.remove<velocity>(e0);
+        w.remove<velocity>(e0);
+        REQUIRE(!w.has<velocity>(e0));
+        REQUIRE(w.get<position>(e0).x == 0);
+
+        // no new archetypes needed for these transitions
+        REQUIRE(w.archetype_count() == 4);
+    }
+}
\ No newline at end of file